@@ -0,0 +1,85 @@
+# Profile guided optimisation build, run by the pgo target with
+#   cmake -DSOURCE_DIR=... -DPGO_BUILD_DIR=... -DCOMPILER=... -DBASELINE=... -P pgo.cmake
+#
+# 1. Build an instrumented swizzles in PGO_BUILD_DIR
+# 2. Run bench as the training workload
+# 3. Rebuild swizzles in the same directory with the profile (GCC matches profiles to object paths)
+# 4. Compare the bench nps of the baseline binary against the PGO binary
+
+if(NOT PGO_BENCH_DEPTH)
+    set(PGO_BENCH_DEPTH 9)
+endif()
+if(NOT PGO_RUNS)
+    set(PGO_RUNS 3)
+endif()
+
+set(PGO_DATA_DIR "${PGO_BUILD_DIR}/pgo-data")
+set(PGO_BINARY "${PGO_BUILD_DIR}/swizzles")
+
+function(run)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Command failed: ${ARGN}")
+    endif()
+endfunction()
+
+# Best nps of several bench runs, the best is the least disturbed by other load
+function(bench_nps binary out_var)
+    set(best 0)
+    foreach(i RANGE 1 ${PGO_RUNS})
+        execute_process(COMMAND ${binary} bench ${PGO_BENCH_DEPTH} OUTPUT_VARIABLE output RESULT_VARIABLE result)
+        if(NOT result EQUAL 0)
+            message(FATAL_ERROR "bench failed: ${binary}")
+        endif()
+        string(REGEX MATCH "NPS: ([0-9]+)" _ "${output}")
+        if(CMAKE_MATCH_1 GREATER best)
+            set(best ${CMAKE_MATCH_1})
+        endif()
+    endforeach()
+    set(${out_var} ${best} PARENT_SCOPE)
+endfunction()
+
+file(REMOVE_RECURSE "${PGO_DATA_DIR}")
+file(MAKE_DIRECTORY "${PGO_DATA_DIR}")
+
+message(STATUS "PGO: building instrumented binary")
+run(${CMAKE_COMMAND}
+    -S "${SOURCE_DIR}"
+    -B "${PGO_BUILD_DIR}"
+    -DCMAKE_BUILD_TYPE=Release
+    -DCMAKE_CXX_COMPILER=${COMPILER}
+    -DSWIZZLES_PGO=GENERATE
+    -DSWIZZLES_PGO_DIR=${PGO_DATA_DIR})
+run(${CMAKE_COMMAND} --build "${PGO_BUILD_DIR}" --target swizzles --clean-first)
+
+message(STATUS "PGO: training with bench ${PGO_BENCH_DEPTH}")
+run(${PGO_BINARY} bench ${PGO_BENCH_DEPTH})
+
+# Clang writes raw profiles that have to be merged first
+file(GLOB raw_profiles "${PGO_DATA_DIR}/*.profraw")
+if(raw_profiles)
+    find_program(LLVM_PROFDATA NAMES llvm-profdata REQUIRED)
+    run(${LLVM_PROFDATA} merge -output=${PGO_DATA_DIR}/swizzles.profdata ${raw_profiles})
+endif()
+
+message(STATUS "PGO: building optimised binary")
+run(${CMAKE_COMMAND} -S "${SOURCE_DIR}" -B "${PGO_BUILD_DIR}" -DSWIZZLES_PGO=USE)
+run(${CMAKE_COMMAND} --build "${PGO_BUILD_DIR}" --target swizzles --clean-first)
+
+message(STATUS "PGO: comparing bench ${PGO_BENCH_DEPTH}, best of ${PGO_RUNS}")
+bench_nps(${BASELINE} baseline_nps)
+bench_nps(${PGO_BINARY} pgo_nps)
+math(EXPR delta "(${pgo_nps} - ${baseline_nps}) * 1000 / ${baseline_nps}")
+math(EXPR delta_whole "${delta} / 10")
+math(EXPR delta_frac "${delta} % 10")
+if(delta_frac LESS 0)
+    math(EXPR delta_frac "-${delta_frac}")
+endif()
+if(delta LESS 0 AND delta_whole EQUAL 0)
+    set(delta_whole "-0")
+endif()
+
+message(STATUS "PGO: baseline ${baseline_nps} nps")
+message(STATUS "PGO: pgo      ${pgo_nps} nps")
+message(STATUS "PGO: delta    ${delta_whole}.${delta_frac}%")
+message(STATUS "PGO: binary   ${PGO_BINARY}")
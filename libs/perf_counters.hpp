@@ -0,0 +1,171 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+// Hardware performance counters for the calling thread using perf_event_open
+// Counters the kernel or hardware won't give us read as zero and report as unavailable
+namespace perf {
+
+enum class Counter : int
+{
+    Cycles = 0,
+    Instructions,
+    BranchMisses,
+    L1DMisses,
+    LLCMisses,
+    Count,
+};
+
+static constexpr std::size_t num_counters = static_cast<std::size_t>(Counter::Count);
+
+struct Counts {
+    std::array<std::uint64_t, num_counters> values = {};
+
+    [[nodiscard]] constexpr auto get(const Counter c) const noexcept -> std::uint64_t {
+        return values[static_cast<std::size_t>(c)];
+    }
+
+    [[nodiscard]] constexpr auto operator-(const Counts &rhs) const noexcept -> Counts {
+        auto result = Counts();
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            result.values[i] = values[i] - rhs.values[i];
+        }
+        return result;
+    }
+
+    constexpr auto operator+=(const Counts &rhs) noexcept -> Counts & {
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            values[i] += rhs.values[i];
+        }
+        return *this;
+    }
+
+    [[nodiscard]] auto ipc() const noexcept -> double {
+        const auto cycles = get(Counter::Cycles);
+        return cycles ? static_cast<double>(get(Counter::Instructions)) / static_cast<double>(cycles) : 0.0;
+    }
+
+    // Misses per thousand instructions
+    [[nodiscard]] auto mpki(const Counter c) const noexcept -> double {
+        const auto instructions = get(Counter::Instructions);
+        return instructions ? 1000.0 * static_cast<double>(get(c)) / static_cast<double>(instructions) : 0.0;
+    }
+};
+
+class PerfCounters {
+   public:
+    PerfCounters() noexcept {
+#ifdef __linux__
+        constexpr auto l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        m_fds[0] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        m_fds[1] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        m_fds[2] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        m_fds[3] = open(PERF_TYPE_HW_CACHE, l1d_read_miss);
+        m_fds[4] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    auto operator=(const PerfCounters &) -> PerfCounters & = delete;
+
+    ~PerfCounters() noexcept {
+#ifdef __linux__
+        for (const auto fd : m_fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    [[nodiscard]] auto available(const Counter c) const noexcept -> bool {
+        return m_fds[static_cast<std::size_t>(c)] >= 0;
+    }
+
+    [[nodiscard]] auto any_available() const noexcept -> bool {
+        for (const auto fd : m_fds) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The counters run from construction, take the difference of two reads to measure a section
+    [[nodiscard]] auto read() const noexcept -> Counts {
+        auto counts = Counts();
+#ifdef __linux__
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            std::uint64_t value = 0;
+            if (m_fds[i] >= 0 && ::read(m_fds[i], &value, sizeof(value)) == sizeof(value)) {
+                counts.values[i] = value;
+            }
+        }
+#endif
+        return counts;
+    }
+
+   private:
+#ifdef __linux__
+    // User space only, which works with the default perf_event_paranoid setting of 2
+    [[nodiscard]] static auto open(const std::uint32_t type, const std::uint64_t config) noexcept -> int {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    std::array<int, num_counters> m_fds = {-1, -1, -1, -1, -1};
+};
+
+// "IPC 2.31  branch-miss 3.2  L1D-miss 11.0  LLC-miss 0.1" with misses per thousand instructions
+inline auto print_summary(std::ostream &os, const PerfCounters &counters, const Counts &counts) -> void {
+    if (!counters.any_available()) {
+        os << "counters unavailable";
+        return;
+    }
+
+    const auto print = [&](const char *name, const bool available, const double value) {
+        os << name << " ";
+        if (available) {
+            os << value;
+        } else {
+            os << "-";
+        }
+    };
+
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os.setf(std::ios::fixed);
+    os.precision(2);
+    const auto has_instructions = counters.available(Counter::Instructions);
+    print("IPC", has_instructions && counters.available(Counter::Cycles), counts.ipc());
+    print("  branch-miss",
+          has_instructions && counters.available(Counter::BranchMisses),
+          counts.mpki(Counter::BranchMisses));
+    print("  L1D-miss", has_instructions && counters.available(Counter::L1DMisses), counts.mpki(Counter::L1DMisses));
+    print("  LLC-miss", has_instructions && counters.available(Counter::LLCMisses), counts.mpki(Counter::LLCMisses));
+    os.flags(flags);
+    os.precision(precision);
+}
+
+}  // namespace perf
+
+#endif
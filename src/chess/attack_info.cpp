@@ -0,0 +1,96 @@
+#include "fill.hpp"
+#include "magic.hpp"
+#include "position.hpp"
+
+namespace chess {
+
+[[nodiscard]] auto Position::attackers(const Square sq, const Bitboard occupied) const noexcept -> Bitboard {
+    const auto bb = Bitboard(sq);
+    auto attackers = Bitboard();
+    attackers |= get_pawns(Colour::White) & (bb.south().east() | bb.south().west());
+    attackers |= get_pawns(Colour::Black) & (bb.north().east() | bb.north().west());
+    attackers |= bb.knight() & get_knights();
+    attackers |= magic::bishop_moves(sq, occupied) & (get_bishops() | get_queens());
+    attackers |= magic::rook_moves(sq, occupied) & (get_rooks() | get_queens());
+    attackers |= bb.adjacent() & get_kings();
+    return attackers;
+}
+
+[[nodiscard]] auto Position::legal_info() const noexcept -> AttackInfo {
+    const auto us = m_turn;
+    const auto them = !us;
+    const auto ksq = get_king(us);
+    const auto rooks = get_rooks(them) | get_queens(them);
+    const auto bishops = get_bishops(them) | get_queens(them);
+    auto info = AttackInfo();
+
+    info.checkers = attackers(ksq, get_occupied()) & colour(them);
+
+    // Pins
+    // - Their sliders that would see our king if our pieces were transparent
+    // - A single piece between them is pinned, it can only be ours as the lookups stop at their pieces
+    for (const auto sq : magic::rook_moves(ksq, colour(them)) & rooks) {
+        const auto between = magic::rook_moves(ksq, Bitboard(sq)) & magic::rook_moves(sq, Bitboard(ksq));
+        if (const auto blockers = between & get_occupied(); blockers.count() == 1) {
+            info.pinned |= blockers;
+        }
+    }
+    for (const auto sq : magic::bishop_moves(ksq, colour(them)) & bishops) {
+        const auto between = magic::bishop_moves(ksq, Bitboard(sq)) & magic::bishop_moves(sq, Bitboard(ksq));
+        if (const auto blockers = between & get_occupied(); blockers.count() == 1) {
+            info.pinned |= blockers;
+        }
+    }
+
+    // Threats
+    if (them == Colour::White) {
+        info.threats |= get_pawns(them).north().east() | get_pawns(them).north().west();
+    } else {
+        info.threats |= get_pawns(them).south().east() | get_pawns(them).south().west();
+    }
+    info.threats |= get_knights(them).knight();
+    info.threats |= get_kings(them).adjacent();
+    info.threats |= fill::slider_attacks(rooks, bishops, get_empty() | Bitboard(ksq));
+
+    return info;
+}
+
+[[nodiscard]] auto Position::attack_info() const noexcept -> AttackInfo {
+    const auto us = m_turn;
+    const auto them = !us;
+    auto info = legal_info();
+
+    // Checks we can give
+    const auto their_ksq = get_king(them);
+    const auto their_king = Bitboard(their_ksq);
+    const auto diagonal = magic::bishop_moves(their_ksq, get_occupied());
+    const auto orthogonal = magic::rook_moves(their_ksq, get_occupied());
+    if (us == Colour::White) {
+        info.check_squares[index(PieceType::Pawn)] = their_king.south().east() | their_king.south().west();
+    } else {
+        info.check_squares[index(PieceType::Pawn)] = their_king.north().east() | their_king.north().west();
+    }
+    info.check_squares[index(PieceType::Knight)] = their_king.knight();
+    info.check_squares[index(PieceType::Bishop)] = diagonal;
+    info.check_squares[index(PieceType::Rook)] = orthogonal;
+    info.check_squares[index(PieceType::Queen)] = diagonal | orthogonal;
+
+    // Discoverers
+    // - Like pins, but our sliders looking at their king through one of our pieces
+    for (const auto sq : magic::rook_moves(their_ksq, colour(them)) & (get_rooks(us) | get_queens(us))) {
+        const auto between = magic::rook_moves(their_ksq, Bitboard(sq)) & magic::rook_moves(sq, their_king);
+        if (const auto blockers = between & get_occupied(); blockers.count() == 1) {
+            info.discoverers |= blockers;
+        }
+    }
+    for (const auto sq : magic::bishop_moves(their_ksq, colour(them)) & (get_bishops(us) | get_queens(us))) {
+        const auto between = magic::bishop_moves(their_ksq, Bitboard(sq)) & magic::bishop_moves(sq, their_king);
+        if (const auto blockers = between & get_occupied(); blockers.count() == 1) {
+            info.discoverers |= blockers;
+        }
+    }
+
+    return info;
+}
+
+}  // namespace chess
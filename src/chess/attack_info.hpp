@@ -0,0 +1,30 @@
+#ifndef CHESS_ATTACK_INFO_HPP
+#define CHESS_ATTACK_INFO_HPP
+
+#include <array>
+#include "bitboard.hpp"
+
+namespace chess {
+
+// What the side to move needs to know about attacks on both kings
+// - Computed once per position and shared between check detection, move generation and legality checks
+struct AttackInfo {
+    [[nodiscard]] constexpr auto in_check() const noexcept -> bool {
+        return !checkers.empty();
+    }
+
+    // Their pieces giving check
+    Bitboard checkers;
+    // Our pieces that can't leave the line between our king and one of their sliders
+    Bitboard pinned;
+    // Every square they attack, seeing through our king so it can't step back along a slider's line
+    Bitboard threats;
+    // The squares each of our piece types would give check from, this and discoverers are left empty by legal_info()
+    std::array<Bitboard, 6> check_squares = {};
+    // Our pieces that uncover a check from one of our sliders if they leave its line
+    Bitboard discoverers;
+};
+
+}  // namespace chess
+
+#endif
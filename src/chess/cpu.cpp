@@ -0,0 +1,76 @@
+#include "cpu.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace chess::cpu {
+
+[[nodiscard]] auto detect() noexcept -> Features {
+    auto result = Features();
+
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+
+    if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+        return result;
+    }
+
+    const auto max_leaf = eax;
+    char vendor[13] = {};
+    std::memcpy(vendor, &ebx, 4);
+    std::memcpy(vendor + 4, &edx, 4);
+    std::memcpy(vendor + 8, &ecx, 4);
+    result.vendor = vendor;
+
+    __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+    const auto base_family = static_cast<int>((eax >> 8) & 0xF);
+    const auto extended_family = static_cast<int>((eax >> 20) & 0xFF);
+    result.family = base_family == 0xF ? base_family + extended_family : base_family;
+    result.popcnt = ecx & bit_POPCNT;
+
+    // AVX registers are only usable if the OS saves them on context switches
+    bool os_avx = false;
+    if ((ecx & bit_OSXSAVE) && (ecx & bit_AVX)) {
+        unsigned int xcr0_lo = 0;
+        unsigned int xcr0_hi = 0;
+        __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        os_avx = (xcr0_lo & 0x6) == 0x6;
+    }
+
+    if (max_leaf >= 7) {
+        __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx);
+        result.bmi2 = ebx & bit_BMI2;
+        result.avx2 = os_avx && (ebx & bit_AVX2);
+    }
+
+    result.fast_pext = result.bmi2 && !(result.vendor == "AuthenticAMD" && result.family < 0x19);
+#endif
+
+    return result;
+}
+
+auto features() noexcept -> const Features & {
+    static const auto result = detect();
+    return result;
+}
+
+auto to_string(const Features &f) noexcept -> std::string {
+    auto result = f.vendor.empty() ? std::string("unknown") : f.vendor;
+    if (f.popcnt) {
+        result += " popcnt";
+    }
+    if (f.bmi2) {
+        result += " bmi2";
+    }
+    if (f.avx2) {
+        result += " avx2";
+    }
+    return result;
+}
+
+}  // namespace chess::cpu
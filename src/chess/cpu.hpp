@@ -0,0 +1,27 @@
+#ifndef CHESS_CPU_HPP
+#define CHESS_CPU_HPP
+
+#include <string>
+
+namespace chess::cpu {
+
+// Instruction set extensions of the CPU we're running on, which may differ from the one we were built for
+struct Features {
+    std::string vendor;
+    int family = 0;
+    bool popcnt = false;
+    bool bmi2 = false;
+    bool avx2 = false;
+    // AMD before Zen 3 implements pext in microcode, slower than a magic multiply
+    bool fast_pext = false;
+};
+
+// Detected with cpuid once, on first use
+[[nodiscard]] auto features() noexcept -> const Features &;
+
+// e.g. "GenuineIntel popcnt bmi2 avx2"
+[[nodiscard]] auto to_string(const Features &f) noexcept -> std::string;
+
+}  // namespace chess::cpu
+
+#endif
@@ -0,0 +1,106 @@
+#include "cuckoo.hpp"
+#include <array>
+#include <cstdlib>
+#include <utility>
+#include "colour.hpp"
+#include "magic.hpp"
+#include "piece.hpp"
+
+namespace chess::cuckoo {
+
+using table_type = std::array<Entry, table_size>;
+
+// Whether a piece on an empty board can move between two squares
+// - Doesn't use the magic tables, which may not have been initialised yet when the cuckoo table is built
+[[nodiscard]] auto is_reachable(const PieceType piece, const Square a, const Square b) noexcept -> bool {
+    const auto dx = std::abs(file(a) - file(b));
+    const auto dy = std::abs(rank(a) - rank(b));
+    const auto orthogonal = dx == 0 || dy == 0;
+    const auto diagonal = dx == dy;
+
+    switch (piece) {
+        case PieceType::Knight:
+            return Bitboard(a).knight().is_occupied(b);
+        case PieceType::Bishop:
+            return diagonal;
+        case PieceType::Rook:
+            return orthogonal;
+        case PieceType::Queen:
+            return diagonal || orthogonal;
+        case PieceType::King:
+            return Bitboard(a).adjacent().is_occupied(b);
+        default:
+            return false;
+    }
+}
+
+[[nodiscard]] auto build_table() noexcept -> table_type {
+    auto table = table_type();
+
+    for (const auto colour : {Colour::White, Colour::Black}) {
+        for (const auto piece :
+             {PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen, PieceType::King}) {
+            for (int a = 0; a < 64; ++a) {
+                for (int b = a + 1; b < 64; ++b) {
+                    const auto from = Square(a);
+                    const auto to = Square(b);
+
+                    if (!is_reachable(piece, from, to)) {
+                        continue;
+                    }
+
+                    auto entry = Entry();
+                    entry.key = zobrist::piece_key(piece, colour, from) ^ zobrist::piece_key(piece, colour, to) ^
+                                zobrist::turn_key();
+                    entry.from = from;
+                    entry.to = to;
+
+                    // Cuckoo insertion, kicking out the existing entries until one lands in an empty slot
+                    auto idx = h1(entry.key);
+                    while (true) {
+                        std::swap(table[idx], entry);
+                        if (entry.from == Square::None) {
+                            break;
+                        }
+                        idx = idx == h1(entry.key) ? h2(entry.key) : h1(entry.key);
+                    }
+                }
+            }
+        }
+    }
+
+    return table;
+}
+
+const auto table = build_table();
+
+[[nodiscard]] auto probe(const zobrist::hash_type key) noexcept -> Entry {
+    if (table[h1(key)].key == key) {
+        return table[h1(key)];
+    } else if (table[h2(key)].key == key) {
+        return table[h2(key)];
+    }
+    return Entry();
+}
+
+[[nodiscard]] auto between(const Square a, const Square b) noexcept -> Bitboard {
+    const auto dx = std::abs(file(a) - file(b));
+    const auto dy = std::abs(rank(a) - rank(b));
+
+    if (dx == 0 || dy == 0) {
+        return magic::rook_moves(a, Bitboard(b)) & magic::rook_moves(b, Bitboard(a));
+    } else if (dx == dy) {
+        return magic::bishop_moves(a, Bitboard(b)) & magic::bishop_moves(b, Bitboard(a));
+    }
+    return Bitboard();
+}
+
+[[nodiscard]] auto num_entries() noexcept -> int {
+    int count = 0;
+    for (const auto &entry : table) {
+        count += entry.from != Square::None;
+    }
+    return count;
+}
+
+}  // namespace chess::cuckoo
@@ -0,0 +1,41 @@
+#ifndef CHESS_CUCKOO_HPP
+#define CHESS_CUCKOO_HPP
+
+#include <cstddef>
+#include "bitboard.hpp"
+#include "square.hpp"
+#include "zobrist.hpp"
+
+namespace chess::cuckoo {
+
+// Every reversible piece move stored by the hash difference it makes
+// - Marcel van Kervinck's cuckoo tables, used to detect upcoming repetitions without making moves
+// - Each move is stored once for both directions, so from and to are interchangeable
+
+struct Entry {
+    zobrist::hash_type key = 0;
+    Square from = Square::None;
+    Square to = Square::None;
+};
+
+static constexpr std::size_t table_size = 8192;
+
+[[nodiscard]] constexpr auto h1(const zobrist::hash_type key) noexcept -> std::size_t {
+    return key & (table_size - 1);
+}
+
+[[nodiscard]] constexpr auto h2(const zobrist::hash_type key) noexcept -> std::size_t {
+    return (key >> 16) & (table_size - 1);
+}
+
+// Returns an entry with Square::None if no reversible move makes this hash difference
+[[nodiscard]] auto probe(const zobrist::hash_type key) noexcept -> Entry;
+
+// The squares strictly between two squares on the same line, or no squares if they aren't aligned
+[[nodiscard]] auto between(const Square a, const Square b) noexcept -> Bitboard;
+
+[[nodiscard]] auto num_entries() noexcept -> int;
+
+}  // namespace chess::cuckoo
+
+#endif
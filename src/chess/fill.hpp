@@ -0,0 +1,175 @@
+#ifndef CHESS_FILL_HPP
+#define CHESS_FILL_HPP
+
+#include <cstdint>
+#include "bitboard.hpp"
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace chess::fill {
+
+// Kogge-Stone occluded fills
+// - Every slider of a set spreads through the empty squares in all its directions at once
+// - Gives the union of their attacks, not the attacks of each piece
+
+// Attacks in one direction, shifting left for positive shifts and right for negative ones
+// The mask clears squares that wrapped around the board edge
+template <int shift, std::uint64_t mask>
+[[nodiscard]] constexpr auto occluded(std::uint64_t gen, std::uint64_t pro) noexcept -> std::uint64_t {
+    constexpr auto step = [](const std::uint64_t bb, const int n) {
+        return shift > 0 ? bb << (n * shift) : bb >> (n * -shift);
+    };
+    pro &= mask;
+    gen |= pro & step(gen, 1);
+    pro &= step(pro, 1);
+    gen |= pro & step(gen, 2);
+    pro &= step(pro, 2);
+    gen |= pro & step(gen, 4);
+    return step(gen, 1) & mask;
+}
+
+[[nodiscard]] constexpr auto rook_scalar(const Bitboard rooks, const Bitboard empty) noexcept -> Bitboard {
+    const auto gen = rooks.data();
+    const auto pro = empty.data();
+    return Bitboard(occluded<8, Bitmask::Full>(gen, pro) | occluded<-8, Bitmask::Full>(gen, pro) |
+                    occluded<1, ~Bitmask::FileA>(gen, pro) | occluded<-1, ~Bitmask::FileH>(gen, pro));
+}
+
+[[nodiscard]] constexpr auto bishop_scalar(const Bitboard bishops, const Bitboard empty) noexcept -> Bitboard {
+    const auto gen = bishops.data();
+    const auto pro = empty.data();
+    return Bitboard(occluded<9, ~Bitmask::FileA>(gen, pro) | occluded<7, ~Bitmask::FileH>(gen, pro) |
+                    occluded<-7, ~Bitmask::FileA>(gen, pro) | occluded<-9, ~Bitmask::FileH>(gen, pro));
+}
+
+#ifdef __AVX512F__
+// All eight directions in one register, the first four lanes for rooks and the last four for bishops
+[[nodiscard]] inline auto sliders_avx512(const Bitboard rooks, const Bitboard bishops, const Bitboard empty) noexcept
+    -> Bitboard {
+    const auto shifts = _mm512_setr_epi64(8, 1, 8, 1, 9, 7, 7, 9);
+    const auto masks = _mm512_setr_epi64(static_cast<long long>(Bitmask::Full),
+                                         static_cast<long long>(~Bitmask::FileA),
+                                         static_cast<long long>(Bitmask::Full),
+                                         static_cast<long long>(~Bitmask::FileH),
+                                         static_cast<long long>(~Bitmask::FileA),
+                                         static_cast<long long>(~Bitmask::FileH),
+                                         static_cast<long long>(~Bitmask::FileA),
+                                         static_cast<long long>(~Bitmask::FileH));
+    // Lanes 2, 3, 6 and 7 shift right
+    constexpr __mmask8 right = 0b11001100;
+
+    // The zero-masked forms of the intrinsics are used throughout, as GCC warns about the undefined source
+    // register the unmasked ones pass
+    constexpr __mmask8 all = 0xFF;
+    const auto step = [&](const __m512i bb, const __m512i n) {
+        return _mm512_mask_blend_epi64(right, _mm512_maskz_sllv_epi64(all, bb, n), _mm512_maskz_srlv_epi64(all, bb, n));
+    };
+
+    const auto shifts2 = _mm512_add_epi64(shifts, shifts);
+    const auto shifts4 = _mm512_add_epi64(shifts2, shifts2);
+    auto gen = _mm512_mask_blend_epi64(0b11110000,
+                                       _mm512_set1_epi64(static_cast<long long>(rooks.data())),
+                                       _mm512_set1_epi64(static_cast<long long>(bishops.data())));
+    auto pro = _mm512_and_si512(_mm512_set1_epi64(static_cast<long long>(empty.data())), masks);
+
+    gen = _mm512_or_si512(gen, _mm512_and_si512(pro, step(gen, shifts)));
+    pro = _mm512_and_si512(pro, step(pro, shifts));
+    gen = _mm512_or_si512(gen, _mm512_and_si512(pro, step(gen, shifts2)));
+    pro = _mm512_and_si512(pro, step(pro, shifts2));
+    gen = _mm512_or_si512(gen, _mm512_and_si512(pro, step(gen, shifts4)));
+    const auto attacks = _mm512_and_si512(step(gen, shifts), masks);
+
+    // Horizontal or of the eight lanes
+    const auto quarter = _mm256_or_si256(_mm512_maskz_extracti64x4_epi64(0xF, attacks, 0),
+                                         _mm512_maskz_extracti64x4_epi64(0xF, attacks, 1));
+    const auto half = _mm_or_si128(_mm256_castsi256_si128(quarter), _mm256_extracti128_si256(quarter, 1));
+    return Bitboard(static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_or_si128(half, _mm_unpackhi_epi64(half, half)))));
+}
+#endif
+
+#ifdef __AVX2__
+// Four directions in one register, the first two lanes shift left and the last two shift right
+[[nodiscard]] inline auto directions_avx2(const Bitboard sliders,
+                                          const Bitboard empty,
+                                          const __m256i shifts,
+                                          const __m256i masks) noexcept -> Bitboard {
+    const auto step = [](const __m256i bb, const __m256i n) {
+        return _mm256_blend_epi32(_mm256_sllv_epi64(bb, n), _mm256_srlv_epi64(bb, n), 0xF0);
+    };
+
+    const auto shifts2 = _mm256_add_epi64(shifts, shifts);
+    const auto shifts4 = _mm256_add_epi64(shifts2, shifts2);
+    auto gen = _mm256_set1_epi64x(static_cast<long long>(sliders.data()));
+    auto pro = _mm256_and_si256(_mm256_set1_epi64x(static_cast<long long>(empty.data())), masks);
+
+    gen = _mm256_or_si256(gen, _mm256_and_si256(pro, step(gen, shifts)));
+    pro = _mm256_and_si256(pro, step(pro, shifts));
+    gen = _mm256_or_si256(gen, _mm256_and_si256(pro, step(gen, shifts2)));
+    pro = _mm256_and_si256(pro, step(pro, shifts2));
+    gen = _mm256_or_si256(gen, _mm256_and_si256(pro, step(gen, shifts4)));
+    const auto attacks = _mm256_and_si256(step(gen, shifts), masks);
+
+    // Horizontal or of the four lanes
+    const auto half = _mm_or_si128(_mm256_castsi256_si128(attacks), _mm256_extracti128_si256(attacks, 1));
+    return Bitboard(static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_or_si128(half, _mm_unpackhi_epi64(half, half)))));
+}
+
+[[nodiscard]] inline auto rook_avx2(const Bitboard rooks, const Bitboard empty) noexcept -> Bitboard {
+    const auto shifts = _mm256_setr_epi64x(8, 1, 8, 1);
+    const auto masks = _mm256_setr_epi64x(static_cast<long long>(Bitmask::Full),
+                                          static_cast<long long>(~Bitmask::FileA),
+                                          static_cast<long long>(Bitmask::Full),
+                                          static_cast<long long>(~Bitmask::FileH));
+    return directions_avx2(rooks, empty, shifts, masks);
+}
+
+[[nodiscard]] inline auto bishop_avx2(const Bitboard bishops, const Bitboard empty) noexcept -> Bitboard {
+    const auto shifts = _mm256_setr_epi64x(9, 7, 7, 9);
+    const auto masks = _mm256_setr_epi64x(static_cast<long long>(~Bitmask::FileA),
+                                          static_cast<long long>(~Bitmask::FileH),
+                                          static_cast<long long>(~Bitmask::FileA),
+                                          static_cast<long long>(~Bitmask::FileH));
+    return directions_avx2(bishops, empty, shifts, masks);
+}
+#endif
+
+// Every square attacked by a set of rooks
+[[nodiscard]] inline auto rook_attacks(const Bitboard rooks, const Bitboard empty) noexcept -> Bitboard {
+#ifdef __AVX2__
+    return rook_avx2(rooks, empty);
+#else
+    return rook_scalar(rooks, empty);
+#endif
+}
+
+// Every square attacked by a set of bishops
+[[nodiscard]] inline auto bishop_attacks(const Bitboard bishops, const Bitboard empty) noexcept -> Bitboard {
+#ifdef __AVX2__
+    return bishop_avx2(bishops, empty);
+#else
+    return bishop_scalar(bishops, empty);
+#endif
+}
+
+// Every square attacked by a set of orthogonal and a set of diagonal sliders, queens belong in both
+[[nodiscard]] inline auto slider_attacks(const Bitboard rooks, const Bitboard bishops, const Bitboard empty) noexcept
+    -> Bitboard {
+#ifdef __AVX512F__
+    return sliders_avx512(rooks, bishops, empty);
+#else
+    return rook_attacks(rooks, empty) | bishop_attacks(bishops, empty);
+#endif
+}
+
+// Rook on a1 of an empty board
+static_assert(rook_scalar(Bitboard(Square::A1), Bitboard(~0x1ULL)) == Bitboard(0x1010101010101FEULL));
+// Bishop on d4 of an empty board
+static_assert(bishop_scalar(Bitboard(Square::D4), Bitboard(~0x8000000ULL)) == Bitboard(0x8041221400142241ULL));
+// Rook on a1 blocked by pieces on a3 and c1
+static_assert(rook_scalar(Bitboard(Square::A1), Bitboard(~0x10005ULL)) == Bitboard(0x10106ULL));
+
+}  // namespace chess::fill
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef CHESS_GENERATE_HPP
+#define CHESS_GENERATE_HPP
+
+#include <utility>
+#include "attack_info.hpp"
+#include "bitboard.hpp"
+#include "magic.hpp"
+#include "movelist.hpp"
+#include "position.hpp"
+
+// Move generation kernels shared by movegen(), captures() and quiets()
+// - The side to move is a template parameter of the pawn, castling and en passant kernels, so there's one
+//   runtime branch on colour per call
+// - Piece moves look the same for both colours, so they take it at runtime rather than being compiled twice
+// - Moves come out in the same order whichever of captures and quiets are asked for
+namespace chess::generate {
+
+[[nodiscard]] constexpr auto path_between(Square a, Square b) noexcept -> Bitboard {
+    if (b < a) {
+        std::swap(a, b);
+    }
+    return Bitboard((Bitmask::Full >> (63 - index(a))) ^ (Bitmask::Full >> (64 - index(b))));
+}
+
+static_assert(path_between(Square::A1, Square::G1) == Bitboard(0x3EULL));
+static_assert(path_between(Square::A1, Square::H1) == Bitboard(0x7EULL));
+static_assert(path_between(Square::B1, Square::H1) == Bitboard(0x7CULL));
+static_assert(path_between(Square::C1, Square::D1) == Bitboard(0x0ULL));
+static_assert(path_between(Square::D1, Square::C1) == Bitboard(0x0ULL));
+static_assert(path_between(Square::D1, Square::F1) == Bitboard(0x10ULL));
+static_assert(path_between(Square::F1, Square::D1) == Bitboard(0x10ULL));
+static_assert(path_between(Square::G1, Square::A1) == Bitboard(0x3EULL));
+static_assert(path_between(Square::H1, Square::A1) == Bitboard(0x7EULL));
+static_assert(path_between(Square::H8, Square::D8) == Bitboard(0x7000000000000000ULL));
+static_assert(path_between(Square::D8, Square::H8) == Bitboard(0x7000000000000000ULL));
+
+template <Colour us>
+[[nodiscard]] constexpr auto forward(const Bitboard bb) noexcept -> Bitboard {
+    if constexpr (us == Colour::White) {
+        return bb.north();
+    } else {
+        return bb.south();
+    }
+}
+
+// How far a pawn's square index moves with each step forward
+template <Colour us>
+static constexpr int up = us == Colour::White ? 8 : -8;
+
+[[nodiscard]] constexpr auto offset(const Square sq, const int n) noexcept -> Square {
+    return static_cast<Square>(index(sq) + n);
+}
+
+inline auto add_promos(MoveList &movelist,
+                       const MoveType type,
+                       const Square fr,
+                       const Square to,
+                       const PieceType captured) noexcept -> void {
+    movelist.emplace_back(type, PieceType::Pawn, fr, to, captured, PieceType::Queen);
+    movelist.emplace_back(type, PieceType::Pawn, fr, to, captured, PieceType::Rook);
+    movelist.emplace_back(type, PieceType::Pawn, fr, to, captured, PieceType::Bishop);
+    movelist.emplace_back(type, PieceType::Pawn, fr, to, captured, PieceType::Knight);
+}
+
+template <Colour us, bool captures, bool quiets>
+auto pawn_moves(const Position &pos, MoveList &movelist) noexcept -> void {
+    constexpr auto promo_rank = us == Colour::White ? Bitmask::Rank7 : Bitmask::Rank2;
+    constexpr auto double_rank = us == Colour::White ? Bitmask::Rank4 : Bitmask::Rank5;
+    const auto pawns = pos.get_pawns(us);
+    const auto promo = pawns & Bitboard(promo_rank);
+    const auto nonpromo = pawns & Bitboard(~promo_rank);
+    const auto empty = pos.get_empty();
+    const auto enemies = pos.colour(!us);
+
+    if constexpr (quiets) {
+        // Singles - Nonpromo
+        for (const auto to : forward<us>(nonpromo) & empty) {
+            movelist.emplace_back(MoveType::Quiet, PieceType::Pawn, offset(to, -up<us>), to);
+        }
+
+        // Singles - Promo
+        for (const auto to : forward<us>(promo) & empty) {
+            add_promos(movelist, MoveType::Promo, offset(to, -up<us>), to, PieceType::None);
+        }
+
+        // Double
+        for (const auto to : forward<us>(forward<us>(pawns) & empty) & Bitboard(double_rank) & empty) {
+            movelist.emplace_back(MoveType::Double, PieceType::Pawn, offset(to, -2 * up<us>), to);
+        }
+    }
+
+    if constexpr (captures) {
+        // Captures - West
+        for (const auto to : forward<us>(nonpromo).west() & enemies) {
+            movelist.emplace_back(MoveType::Capture, PieceType::Pawn, offset(to, 1 - up<us>), to, pos.piece_on(to));
+        }
+
+        // Captures - East
+        for (const auto to : forward<us>(nonpromo).east() & enemies) {
+            movelist.emplace_back(MoveType::Capture, PieceType::Pawn, offset(to, -1 - up<us>), to, pos.piece_on(to));
+        }
+
+        // Captures promo - West
+        for (const auto to : forward<us>(promo).west() & enemies) {
+            add_promos(movelist, MoveType::PromoCapture, offset(to, 1 - up<us>), to, pos.piece_on(to));
+        }
+
+        // Captures promo - East
+        for (const auto to : forward<us>(promo).east() & enemies) {
+            add_promos(movelist, MoveType::PromoCapture, offset(to, -1 - up<us>), to, pos.piece_on(to));
+        }
+    }
+}
+
+template <bool captures, bool quiets>
+auto piece_moves(const Position &pos, const Colour us, MoveList &movelist) noexcept -> void {
+    const auto occupied = pos.get_occupied();
+    const auto empty = pos.get_empty();
+    const auto enemies = pos.colour(!us);
+
+    const auto add = [&](const PieceType piece, const Square fr, const Bitboard moves) {
+        if constexpr (captures) {
+            for (const auto to : moves & enemies) {
+                movelist.emplace_back(MoveType::Capture, piece, fr, to, pos.piece_on(to));
+            }
+        }
+        if constexpr (quiets) {
+            for (const auto to : moves & empty) {
+                movelist.emplace_back(MoveType::Quiet, piece, fr, to);
+            }
+        }
+    };
+
+    for (const auto fr : pos.get_knights(us)) {
+        add(PieceType::Knight, fr, Bitboard(fr).knight());
+    }
+    for (const auto fr : pos.get_bishops(us)) {
+        add(PieceType::Bishop, fr, magic::bishop_moves(fr, occupied));
+    }
+    for (const auto fr : pos.get_rooks(us)) {
+        add(PieceType::Rook, fr, magic::rook_moves(fr, occupied));
+    }
+    for (const auto fr : pos.get_queens(us)) {
+        add(PieceType::Queen, fr, magic::queen_moves(fr, occupied));
+    }
+    const auto ksq = pos.get_king(us);
+    add(PieceType::King, ksq, Bitboard(ksq).adjacent());
+}
+
+template <Colour us>
+auto castling_moves(const Position &pos, const AttackInfo &info, MoveList &movelist) noexcept -> void {
+    constexpr auto ksc = us == Colour::White ? CastleType::WhiteKingSide : CastleType::BlackKingSide;
+    constexpr auto qsc = us == Colour::White ? CastleType::WhiteQueenSide : CastleType::BlackQueenSide;
+    constexpr auto rank = us == Colour::White ? 0 : 56;
+
+    if (info.in_check()) {
+        return;
+    }
+
+    const auto ksq = pos.get_king(us);
+
+    // The king and rook may only pass over each other, and the king can't pass through check
+    const auto castle = [&](const CastleType type,
+                            const MoveType move_type,
+                            const Square king_to,
+                            const Square rook_to) {
+        if (!pos.can_castle(type)) {
+            return;
+        }
+
+        const auto rook_sq = pos.castle_rook(type);
+        const auto blockers = pos.get_occupied() ^ Bitboard(ksq) ^ Bitboard(rook_sq);
+
+        const auto king_path = (path_between(ksq, king_to) | Bitboard(king_to)) & ~Bitboard(ksq);
+        const auto king_path_clear = (king_path & blockers).empty();
+
+        const auto rook_path = path_between(rook_to, rook_sq) | Bitboard(rook_to);
+        const auto rook_path_clear = (rook_path & blockers).empty();
+
+        if (king_path_clear && rook_path_clear && (king_path & info.threats).empty()) {
+            movelist.emplace_back(move_type, PieceType::King, ksq, rook_sq);
+        }
+    };
+
+    castle(ksc, MoveType::KSC, static_cast<Square>(rank + 6), static_cast<Square>(rank + 5));
+    castle(qsc, MoveType::QSC, static_cast<Square>(rank + 2), static_cast<Square>(rank + 3));
+}
+
+template <Colour us>
+auto enpassant_moves(const Position &pos, MoveList &movelist) noexcept -> void {
+    const auto ep = pos.enpassant();
+    if (ep == Square::None) {
+        return;
+    }
+
+    const auto pawns = forward<us>(pos.get_pawns(us));
+
+    // West
+    if (pawns.west() & Bitboard(ep)) {
+        movelist.emplace_back(MoveType::EnPassant, PieceType::Pawn, offset(ep, 1 - up<us>), ep, PieceType::Pawn);
+    }
+
+    // East
+    if (pawns.east() & Bitboard(ep)) {
+        movelist.emplace_back(MoveType::EnPassant, PieceType::Pawn, offset(ep, -1 - up<us>), ep, PieceType::Pawn);
+    }
+}
+
+}  // namespace chess::generate
+
+#endif
@@ -0,0 +1,63 @@
+#include "magic.hpp"
+#include "position.hpp"
+
+namespace chess {
+
+[[nodiscard]] auto Position::gives_check(const Move &move) const noexcept -> bool {
+    return gives_check(move, attack_info());
+}
+
+[[nodiscard]] auto Position::gives_check(const Move &move, const AttackInfo &info) const noexcept -> bool {
+    const auto us = m_turn;
+    const auto their_ksq = get_king(!us);
+    const auto from = Bitboard(move.from());
+    const auto to = Bitboard(move.to());
+
+    // Direct checks
+    // - A promotion's line to the king can pass through the square the pawn left, so it's looked at below
+    if (move.piece() != PieceType::King && move.promo() == PieceType::None &&
+        (info.check_squares[index(move.piece())] & to)) {
+        return true;
+    }
+
+    // Nothing is uncovered and the piece that moved doesn't check directly
+    const auto is_special = move.type() == MoveType::EnPassant || move.type() == MoveType::KSC ||
+                            move.type() == MoveType::QSC || move.promo() != PieceType::None;
+    if (!is_special && !(info.discoverers & from)) {
+        return false;
+    }
+
+    // Look for checks from our sliders with the board after the move
+    auto occupied = (get_occupied() ^ from) | to;
+    auto rooks = (get_rooks(us) | get_queens(us)) & ~from;
+    auto bishops = (get_bishops(us) | get_queens(us)) & ~from;
+
+    if (move.type() == MoveType::EnPassant) {
+        occupied ^= us == Colour::White ? to.south() : to.north();
+    } else if (move.type() == MoveType::KSC || move.type() == MoveType::QSC) {
+        // The king and rook swap places, and the king never gives check itself
+        const auto is_ksc = move.type() == MoveType::KSC;
+        const auto king_to = us == Colour::White ? (is_ksc ? Square::G1 : Square::C1)
+                                                 : (is_ksc ? Square::G8 : Square::C8);
+        const auto rook_to = us == Colour::White ? (is_ksc ? Square::F1 : Square::D1)
+                                                 : (is_ksc ? Square::F8 : Square::D8);
+        occupied = (get_occupied() ^ from ^ to) | Bitboard(king_to) | Bitboard(rook_to);
+        rooks = (rooks ^ to) | Bitboard(rook_to);
+    }
+
+    // Promotions
+    if (move.promo() == PieceType::Knight && (to.knight() & Bitboard(their_ksq))) {
+        return true;
+    }
+    if (move.promo() == PieceType::Rook || move.promo() == PieceType::Queen) {
+        rooks |= to;
+    }
+    if (move.promo() == PieceType::Bishop || move.promo() == PieceType::Queen) {
+        bishops |= to;
+    }
+
+    return !(magic::rook_moves(their_ksq, occupied) & rooks).empty() ||
+           !(magic::bishop_moves(their_ksq, occupied) & bishops).empty();
+}
+
+}  // namespace chess
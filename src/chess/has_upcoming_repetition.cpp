@@ -0,0 +1,37 @@
+#include <algorithm>
+#include "cuckoo.hpp"
+#include "position.hpp"
+
+namespace chess {
+
+[[nodiscard]] auto Position::has_upcoming_repetition(const int ply) const noexcept -> bool {
+    // Positions before the last irreversible move can't be repeated
+    const auto end = std::min({m_halfmoves, m_hashes.size(), static_cast<std::size_t>(std::max(ply - 1, 0))});
+    if (end < 3) {
+        return false;
+    }
+
+    const auto occupied = get_occupied();
+
+    // The position i plies ago has the other side to move when i is odd, so a single move by us can reach it
+    for (std::size_t i = 3; i <= end; i += 2) {
+        const auto diff = m_hash ^ m_hashes[m_hashes.size() - i];
+        const auto entry = cuckoo::probe(diff);
+
+        if (entry.from == Square::None) {
+            continue;
+        }
+
+        // The move has to be ours and its path has to be clear
+        const auto sq = is_occupied(entry.from) ? entry.from : entry.to;
+        if (!get_us().is_occupied(sq) || (cuckoo::between(entry.from, entry.to) & occupied)) {
+            continue;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+}  // namespace chess
@@ -1,3 +1,4 @@
+#include "fill.hpp"
 #include "magic.hpp"
 #include "position.hpp"
 
@@ -48,6 +49,13 @@ namespace chess {
         return true;
     }
 
+    // One fill for all the sliders beats a pair of lookups for each square, such as a castling path
+    if (bb.count() > 1) {
+        const auto rooks = get_rooks(side) | get_queens(side);
+        const auto bishops = get_bishops(side) | get_queens(side);
+        return !(fill::slider_attacks(rooks, bishops, ~get_occupied()) & bb).empty();
+    }
+
     for (const auto sq : bb) {
         // Bishops & Queens
         if (magic::bishop_moves(sq, get_occupied()) & (get_bishops(side) | get_queens(side))) {
@@ -0,0 +1,49 @@
+#include "position.hpp"
+
+namespace chess {
+
+[[nodiscard]] auto Position::is_legal(const Move &move, const AttackInfo &info) const noexcept -> bool {
+    const auto us = m_turn;
+    const auto them = colour(!us);
+    const auto ksq = get_king(us);
+    const auto from = Bitboard(move.from());
+    const auto to = Bitboard(move.to());
+
+    // Castling
+    // - movegen has already checked the king isn't in check and doesn't pass through an attacked square
+    // - In Chess960 the castling rook can shield the king's destination, so look with both pieces moved
+    if (move.type() == MoveType::KSC || move.type() == MoveType::QSC) {
+        const auto is_ksc = move.type() == MoveType::KSC;
+        const auto king_to = us == Colour::White ? (is_ksc ? Square::G1 : Square::C1)
+                                                 : (is_ksc ? Square::G8 : Square::C8);
+        const auto rook_to = us == Colour::White ? (is_ksc ? Square::F1 : Square::D1)
+                                                 : (is_ksc ? Square::F8 : Square::D8);
+        const auto occupied = (get_occupied() ^ from ^ to) | Bitboard(king_to) | Bitboard(rook_to);
+        return (attackers(king_to, occupied) & them).empty();
+    }
+
+    // The threats already see through the king
+    if (move.piece() == PieceType::King) {
+        return (info.threats & to).empty();
+    }
+
+    // Nothing else can put our king in check
+    if (!info.in_check() && !(info.pinned & from) && move.type() != MoveType::EnPassant) {
+        return true;
+    }
+
+    // Only the king can escape a double check
+    if (info.checkers.count() > 1) {
+        return false;
+    }
+
+    // Check for attacks on the king with the board after the move
+    auto captured = to;
+    if (move.type() == MoveType::EnPassant) {
+        captured = us == Colour::White ? to.south() : to.north();
+    }
+    const auto occupied = (get_occupied() ^ from ^ captured) | to;
+    return (attackers(ksq, occupied) & them & ~captured).empty();
+}
+
+}  // namespace chess
@@ -1,6 +1,24 @@
 #include "magic.hpp"
 #include <array>
+#include <bit>
 #include <cstdint>
+#include <vector>
+#include "cpu.hpp"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define CHESS_PEXT
+#endif
+
+// How bishop_moves() and rook_moves() pick their lookup
+// - Built for a CPU with fast pext, they always use it. AMD before Zen 3 runs pext in microcode
+// - Portable builds check the CPU once at startup
+// - Anything else always uses the magic tables
+#if defined(CHESS_PEXT) && defined(__BMI2__) && !defined(__bdver4__) && !defined(__znver1__) && !defined(__znver2__)
+#define CHESS_PEXT_ALWAYS
+#elif defined(CHESS_PEXT) && defined(SWIZZLES_PORTABLE)
+#define CHESS_PEXT_RUNTIME
+#endif
 
 namespace chess::magic {
 
@@ -251,20 +269,139 @@ constexpr auto rook_masks = calculate_rook_masks();
 
 auto magic_moves = generate_magic_moves();
 
-[[nodiscard]] auto bishop_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard {
+#ifdef CHESS_PEXT
+// Dense tables indexed by pext(occupancy, mask), 5248 bishop and 102400 rook entries
+struct PextTables {
+    std::array<std::size_t, 64> bishop_offsets = {};
+    std::array<std::size_t, 64> rook_offsets = {};
+    std::vector<std::uint64_t> moves;
+};
+
+// Enumerating subsets with permute() visits them in the same order as their pext index, so no pext is needed here
+[[nodiscard]] auto generate_pext_tables() -> PextTables {
+    auto result = PextTables();
+    if (!cpu::features().bmi2) {
+        return result;
+    }
+
+    std::size_t size = 0;
+    for (int i = 0; i < 64; ++i) {
+        result.bishop_offsets[i] = size;
+        size += 1ULL << std::popcount(bishop_masks[i]);
+        result.rook_offsets[i] = size;
+        size += 1ULL << std::popcount(rook_masks[i]);
+    }
+    result.moves.resize(size);
+
+    for (int i = 0; i < 64; ++i) {
+        std::uint64_t perm = 0;
+        std::size_t idx = 0;
+
+        // Bishops
+        perm = 0;
+        idx = result.bishop_offsets[i];
+        do {
+            result.moves[idx++] = calculate_bishop_moves(i, perm);
+        } while ((perm = permute(bishop_masks[i], perm)));
+
+        // Rooks
+        perm = 0;
+        idx = result.rook_offsets[i];
+        do {
+            result.moves[idx++] = calculate_rook_moves(i, perm);
+        } while ((perm = permute(rook_masks[i], perm)));
+    }
+
+    return result;
+}
+
+const auto pext_tables = generate_pext_tables();
+
+// Compiled for BMI2 even in builds that don't assume it, only called once cpuid says it's there
+[[nodiscard]] __attribute__((target("bmi2"))) auto pext_bishop(const int idx, const std::uint64_t occ) noexcept
+    -> std::uint64_t {
+    return pext_tables.moves[pext_tables.bishop_offsets[idx] + _pext_u64(occ, bishop_masks[idx])];
+}
+
+[[nodiscard]] __attribute__((target("bmi2"))) auto pext_rook(const int idx, const std::uint64_t occ) noexcept
+    -> std::uint64_t {
+    return pext_tables.moves[pext_tables.rook_offsets[idx] + _pext_u64(occ, rook_masks[idx])];
+}
+#endif
+
+#ifdef CHESS_PEXT_RUNTIME
+// Never changes after startup
+const bool use_pext = cpu::features().fast_pext;
+#endif
+
+[[nodiscard]] auto magic_bishop_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard {
     const auto idx = index(sq);
     return Bitboard(
         *(magic_moves.data() + bishops[idx].second + (((occ.data() & bishop_masks[idx]) * bishops[idx].first) >> 55)));
 }
 
-[[nodiscard]] auto rook_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard {
+[[nodiscard]] auto magic_rook_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard {
     const auto idx = index(sq);
     return Bitboard(
         *(magic_moves.data() + rooks[idx].second + (((occ.data() & rook_masks[idx]) * rooks[idx].first) >> 52)));
 }
 
+[[nodiscard]] auto pext_bishop_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard {
+#ifdef CHESS_PEXT
+    return Bitboard(pext_bishop(index(sq), occ.data()));
+#else
+    return magic_bishop_moves(sq, occ);
+#endif
+}
+
+[[nodiscard]] auto pext_rook_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard {
+#ifdef CHESS_PEXT
+    return Bitboard(pext_rook(index(sq), occ.data()));
+#else
+    return magic_rook_moves(sq, occ);
+#endif
+}
+
+[[nodiscard]] auto bishop_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard {
+#if defined(CHESS_PEXT_ALWAYS)
+    return pext_bishop_moves(sq, occ);
+#elif defined(CHESS_PEXT_RUNTIME)
+    return use_pext ? pext_bishop_moves(sq, occ) : magic_bishop_moves(sq, occ);
+#else
+    return magic_bishop_moves(sq, occ);
+#endif
+}
+
+[[nodiscard]] auto rook_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard {
+#if defined(CHESS_PEXT_ALWAYS)
+    return pext_rook_moves(sq, occ);
+#elif defined(CHESS_PEXT_RUNTIME)
+    return use_pext ? pext_rook_moves(sq, occ) : magic_rook_moves(sq, occ);
+#else
+    return magic_rook_moves(sq, occ);
+#endif
+}
+
 [[nodiscard]] auto queen_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard {
     return bishop_moves(sq, occ) | rook_moves(sq, occ);
 }
 
+auto pext_supported() noexcept -> bool {
+#ifdef CHESS_PEXT
+    return cpu::features().bmi2;
+#else
+    return false;
+#endif
+}
+
+auto backend() noexcept -> std::string_view {
+#if defined(CHESS_PEXT_ALWAYS)
+    return "pext";
+#elif defined(CHESS_PEXT_RUNTIME)
+    return use_pext ? "pext" : "magic";
+#else
+    return "magic";
+#endif
+}
+
 }  // namespace chess::magic
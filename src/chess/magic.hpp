@@ -1,6 +1,7 @@
 #ifndef CHESS_MAGIC_HPP
 #define CHESS_MAGIC_HPP
 
+#include <string_view>
 #include "bitboard.hpp"
 #include "square.hpp"
 
@@ -10,6 +11,19 @@ namespace chess::magic {
 [[nodiscard]] auto rook_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard;
 [[nodiscard]] auto queen_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard;
 
+// PEXT needs BMI2, and is only picked by default where it's faster than a magic multiply
+[[nodiscard]] auto pext_supported() noexcept -> bool;
+
+// Each lookup by name, so tests and benchmarks can compare them whatever bishop_moves() and rook_moves() use
+// - The pext ones may only be called if pext_supported()
+[[nodiscard]] auto magic_bishop_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard;
+[[nodiscard]] auto magic_rook_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard;
+[[nodiscard]] auto pext_bishop_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard;
+[[nodiscard]] auto pext_rook_moves(const Square sq, const Bitboard occ) noexcept -> Bitboard;
+
+// The slider lookup in use
+[[nodiscard]] auto backend() noexcept -> std::string_view;
+
 }  // namespace chess::magic
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef CHESS_POSITION_HPP
 #define CHESS_POSITION_HPP
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -8,6 +9,7 @@
 #include <string>
 #include <string_view>
 #include <vector>
+#include "attack_info.hpp"
 #include "bitboard.hpp"
 #include "colour.hpp"
 #include "move.hpp"
@@ -57,12 +59,39 @@ class Position {
 
     [[nodiscard]] auto movegen() const noexcept -> MoveList;
 
+    [[nodiscard]] auto movegen(const AttackInfo &info) const noexcept -> MoveList;
+
     [[nodiscard]] auto captures() const noexcept -> MoveList;
 
+    // Everything movegen() gives apart from captures() and en passant, for generating moves in stages
+    [[nodiscard]] auto quiets() const noexcept -> MoveList;
+
+    [[nodiscard]] auto quiets(const AttackInfo &info) const noexcept -> MoveList;
+
     [[nodiscard]] auto is_attacked(const Square sq, const Colour side) const noexcept -> bool;
 
     [[nodiscard]] auto is_attacked(const Bitboard bb, const Colour side) const noexcept -> bool;
 
+    // Pieces of both sides attacking a square, with the given squares occupied
+    [[nodiscard]] auto attackers(const Square sq, const Bitboard occupied) const noexcept -> Bitboard;
+
+    // The checkers, pins and threats, all that move generation and is_legal() look at
+    [[nodiscard]] auto legal_info() const noexcept -> AttackInfo;
+
+    // legal_info() with the check squares and discoverers gives_check() needs
+    [[nodiscard]] auto attack_info() const noexcept -> AttackInfo;
+
+    /*
+     * - Whether a move from movegen leaves our king safe, without making the move
+     * - Most moves are decided by the pins and checks in info, the rest look at the board after the move
+     */
+    [[nodiscard]] auto is_legal(const Move &move, const AttackInfo &info) const noexcept -> bool;
+
+    // Whether a move from movegen checks the other king, without making it
+    [[nodiscard]] auto gives_check(const Move &move) const noexcept -> bool;
+
+    [[nodiscard]] auto gives_check(const Move &move, const AttackInfo &info) const noexcept -> bool;
+
     [[nodiscard]] constexpr auto hash() const noexcept -> zobrist::hash_type {
         return m_hash;
     }
@@ -73,16 +102,33 @@ class Position {
 
     [[nodiscard]] auto predict_hash(const Move move) const noexcept -> zobrist::hash_type;
 
+    // How many times the current position has occurred
+    // - Only positions since the last irreversible move with the same side to move can match
+    // - The position 2 plies ago can't match either, it takes at least 2 moves each to get back
     [[nodiscard]] auto num_repeats() const noexcept -> int {
         int repeats = 1;
-        for (std::size_t i = 2; i <= m_history.size() && i <= m_halfmoves; i += 2) {
-            if (m_history[m_history.size() - i].hash == m_hash) {
-                repeats++;
-            }
+        const auto end = std::min(m_hashes.size(), m_halfmoves);
+        for (std::size_t i = 4; i <= end; i += 2) {
+            repeats += m_hashes[m_hashes.size() - i] == m_hash;
         }
         return repeats;
     }
 
+    // Whether the current position has occurred before, stopping at the first match
+    [[nodiscard]] auto is_repetition() const noexcept -> bool {
+        const auto end = std::min(m_hashes.size(), m_halfmoves);
+        for (std::size_t i = 4; i <= end; i += 2) {
+            if (m_hashes[m_hashes.size() - i] == m_hash) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Whether the side to move has a reversible move that repeats one of the last ply positions
+    // - The search passes its distance from the root so only positions in the search tree count
+    [[nodiscard]] auto has_upcoming_repetition(const int ply) const noexcept -> bool;
+
     [[nodiscard]] constexpr auto get_us() const noexcept -> Bitboard {
         return m_colour[static_cast<std::size_t>(m_turn)];
     }
@@ -249,35 +295,31 @@ class Position {
             : move(m),
               castling(pos.m_castling),
               halfmoves(pos.m_halfmoves),
-              enpassant(pos.m_enpassant),
-              hash(pos.hash()) {
+              enpassant(pos.m_enpassant) {
         }
 
-        [[nodiscard]] constexpr History(const Move &m,
-                                        const int c,
-                                        const int hm,
-                                        const Square ep,
-                                        const zobrist::hash_type h)
-            : move(m), castling(c), halfmoves(hm), enpassant(ep), hash(h) {
+        [[nodiscard]] constexpr History(const Move &m, const int c, const int hm, const Square ep)
+            : move(m), castling(c), halfmoves(hm), enpassant(ep) {
         }
 
         Move move;
         int castling;
         std::size_t halfmoves;
         Square enpassant;
-        zobrist::hash_type hash;
     };
 
     auto push_history(const Move &move) noexcept -> void {
         m_history.emplace_back(*this, move);
+        m_hashes.push_back(m_hash);
     }
 
     auto restore_history() noexcept -> void {
         m_castling = m_history.back().castling;
         m_halfmoves = m_history.back().halfmoves;
         m_enpassant = m_history.back().enpassant;
-        m_hash = m_history.back().hash;
+        m_hash = m_hashes.back();
         m_history.pop_back();
+        m_hashes.pop_back();
     }
 
     std::array<Bitboard, 2> m_colour = {};
@@ -290,6 +332,8 @@ class Position {
     Square m_enpassant = Square::None;
     zobrist::hash_type m_hash = 0;
     std::vector<History> m_history;
+    // Kept apart from m_history so repetition checks scan a dense array of hashes
+    std::vector<zobrist::hash_type> m_hashes;
 };
 
 inline auto operator<<(std::ostream &os, const Position &pos) noexcept -> std::ostream & {
@@ -0,0 +1,27 @@
+#include "generate.hpp"
+#include "position.hpp"
+
+namespace chess {
+
+template <Colour us>
+[[nodiscard]] auto quiets_us(const Position &pos, const AttackInfo &info) noexcept -> MoveList {
+    MoveList movelist;
+    generate::pawn_moves<us, false, true>(pos, movelist);
+    generate::piece_moves<false, true>(pos, us, movelist);
+    generate::castling_moves<us>(pos, info, movelist);
+    return movelist;
+}
+
+[[nodiscard]] auto Position::quiets() const noexcept -> MoveList {
+    return quiets(legal_info());
+}
+
+[[nodiscard]] auto Position::quiets(const AttackInfo &info) const noexcept -> MoveList {
+    if (m_turn == Colour::White) {
+        return quiets_us<Colour::White>(*this, info);
+    } else {
+        return quiets_us<Colour::Black>(*this, info);
+    }
+}
+
+}  // namespace chess
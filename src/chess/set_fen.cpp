@@ -37,6 +37,7 @@ auto Position::set_fen(const std::string_view fen) -> void {
     m_enpassant = Square::None;
     m_hash = 0;
     m_history.clear();
+    m_hashes.clear();
 
     const auto parts = split(fen, " ");
 
@@ -0,0 +1,41 @@
+#include "bench.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <tt.hpp>
+#include "search/root.hpp"
+#include "search/settings.hpp"
+#include "ttentry.hpp"
+#include "uci/state.hpp"
+
+namespace swizzles {
+
+auto bench(const int depth, const int hash) noexcept -> BenchResults {
+    auto results = BenchResults();
+
+    auto state = uci::UCIState();
+    state.hash.val = std::clamp(hash, state.hash.min, state.hash.max);
+    state.tt = std::make_shared<TT<TTEntry>>(state.hash.val);
+    results.hash = state.hash.val;
+
+    // Search settings
+    auto settings = search::SearchSettings();
+    settings.type = search::SearchType::Depth;
+    settings.depth = depth;
+    std::atomic<bool> stop = false;
+
+    for (const auto &fen : bench_fens) {
+        state.pos.set_fen(fen);
+
+        const auto t0 = std::chrono::steady_clock::now();
+        const auto search_results = search::root(state, settings, stop);
+        const auto t1 = std::chrono::steady_clock::now();
+
+        results.nodes += search_results.nodes;
+        results.time += std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+    }
+
+    return results;
+}
+
+}  // namespace swizzles
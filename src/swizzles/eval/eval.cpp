@@ -4,6 +4,14 @@
 #include <chess/position.hpp>
 #include "pst.hpp"
 
+// A portable build can't assume popcnt, so eval is compiled for several ISA levels and the best is picked at load time
+// flatten inlines everything eval calls so the helpers get the clone's ISA too
+#if defined(SWIZZLES_PORTABLE) && defined(__x86_64__) && defined(__GNUC__)
+#define EVAL_TARGETS __attribute__((target_clones("arch=x86-64-v3", "popcnt", "default"), flatten))
+#else
+#define EVAL_TARGETS
+#endif
+
 namespace swizzles::eval {
 
 static constexpr std::array<Score, 6> material = {{
@@ -167,7 +175,7 @@ template <chess::Colour us>
     return ((score.mg() * (256 - phase)) + (score.eg() * phase)) / 256;
 }
 
-[[nodiscard]] auto eval(const chess::Position &pos) noexcept -> int {
+[[nodiscard]] EVAL_TARGETS auto eval(const chess::Position &pos) noexcept -> int {
     Score score;
     score += eval_us<chess::Colour::White>(pos);
     score -= eval_us<chess::Colour::Black>(pos);
@@ -180,4 +188,20 @@ template <chess::Colour us>
     }
 }
 
+auto target() noexcept -> std::string_view {
+#if defined(SWIZZLES_PORTABLE) && defined(__x86_64__) && defined(__GNUC__)
+    // Asks the same question as the target_clones resolver, x86-64-v3 covers AVX2, BMI1/2, FMA, F16C, LZCNT and MOVBE
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("x86-64-v3")) {
+        return "x86-64-v3";
+    } else if (__builtin_cpu_supports("popcnt")) {
+        return "popcnt";
+    } else {
+        return "generic";
+    }
+#else
+    return "native";
+#endif
+}
+
 }  // namespace swizzles::eval
@@ -1,6 +1,8 @@
 #ifndef SWIZZLES_EVAL_HPP
 #define SWIZZLES_EVAL_HPP
 
+#include <string_view>
+
 namespace chess {
 class Position;
 }  // namespace chess
@@ -9,6 +11,9 @@ namespace swizzles::eval {
 
 [[nodiscard]] auto eval(const chess::Position &pos) noexcept -> int;
 
+// Which build of eval runs on this CPU
+[[nodiscard]] auto target() noexcept -> std::string_view;
+
 }  // namespace swizzles::eval
 
 #endif
@@ -1,18 +1,75 @@
+#include <chess/cpu.hpp>
+#include <chess/magic.hpp>
 #include <iostream>
+#include <sstream>
+#include "bench.hpp"
+#include "eval/eval.hpp"
 #include "uci/uci.hpp"
 
-int main() {
+int main(const int argc, const char **argv) {
     std::string input;
-    std::getline(std::cin, input);
 
-    if (input == "uci") {
+    // Run a single command from the arguments, e.g. "swizzles bench 10"
+    if (argc > 1) {
+        input = argv[1];
+        for (int i = 2; i < argc; ++i) {
+            input += " ";
+            input += argv[i];
+        }
+    } else {
+        std::getline(std::cin, input);
+    }
+
+    auto ss = std::stringstream(input);
+    std::string word;
+    ss >> word;
+
+    if (word == "uci") {
         swizzles::uci::listen();
-    } else if (input == "about") {
+    } else if (word == "bench") {
+        // bench [depth] [threads] [hash]
+        // - The search doesn't start helper threads yet, so any thread count searches with one
+        int depth = 9;
+        int threads = 1;
+        int hash = 16;
+        int value = 0;
+        if (ss >> value) {
+            depth = value;
+        }
+        if (ss >> value) {
+            threads = value;
+        }
+        if (ss >> value) {
+            hash = value;
+        }
+
+        if (threads > 1) {
+            std::cerr << "bench is single threaded, ignoring threads " << threads << std::endl;
+        }
+
+        const auto results = swizzles::bench(depth, hash);
+        const auto ms = results.time.count();
+        std::cout << "CPU: " << chess::cpu::to_string(chess::cpu::features()) << "\n";
+        std::cout << "Eval: " << swizzles::eval::target() << "\n";
+        std::cout << "Sliders: " << chess::magic::backend() << "\n";
+        std::cout << "Depth: " << depth << "\n";
+        std::cout << "Threads: 1\n";
+        std::cout << "Hash: " << results.hash << "\n";
+        std::cout << "Time: " << ms << "ms\n";
+        std::cout << "Nodes: " << results.nodes << "\n";
+        std::cout << "NPS: " << (ms > 0 ? 1000 * results.nodes / ms : 0) << std::endl;
+    } else if (word == "about") {
 #ifdef NDEBUG
         std::cout << "Build: Release\n";
 #else
         std::cout << "Build: Debug\n";
 #endif
+#ifdef SWIZZLES_PORTABLE
+        std::cout << "Target: Portable\n";
+#else
+        std::cout << "Target: Native\n";
+#endif
+        std::cout << "CPU: " << chess::cpu::to_string(chess::cpu::features()) << "\n";
         std::cout << "Date: " << __DATE__ << "\n";
         std::cout << "Time: " << __TIME__ << "\n";
         std::cout << "URL: https://github.com/kz04px/swizzles\n";
@@ -12,12 +12,25 @@ class SearchController {
    public:
     using clock_type = std::chrono::steady_clock;
 
+    // How many nodes a thread searches between calls to update()
+    static constexpr std::uint64_t poll_frequency = 1024;
+
     [[nodiscard]] SearchController(const SearchSettings &settings, std::atomic<bool> &stop) noexcept
-        : m_settings(settings), m_stop(stop) {
+        : m_settings(settings), m_external_stop(stop) {
+    }
+
+    [[nodiscard]] SearchController(const SearchSettings &settings,
+                                   std::atomic<bool> &stop,
+                                   std::atomic<bool> &ponder) noexcept
+        : m_settings(settings), m_external_stop(stop), m_external_ponder(&ponder), m_pondering(ponder) {
+    }
+
+    [[nodiscard]] auto settings() const noexcept -> const SearchSettings & {
+        return m_settings;
     }
 
     [[nodiscard]] auto should_stop() const noexcept -> bool {
-        return m_stop;
+        return m_stop.load(std::memory_order_relaxed);
     }
 
     [[nodiscard]] auto elapsed() const noexcept -> std::chrono::milliseconds {
@@ -36,6 +49,9 @@ class SearchController {
 
     auto set_depth(const int n) noexcept -> void {
         m_current_depth = n;
+        if (m_settings.type == SearchType::Depth && n > m_settings.depth) {
+            m_stop = true;
+        }
     }
 
     auto set_max_time(const int n) noexcept -> void {
@@ -44,20 +60,65 @@ class SearchController {
 
     auto start() noexcept -> void {
         m_start_time = clock_type::now();
+        m_nodes = 0;
+    }
+
+    // Time limits don't apply while pondering
+    // - On ponderhit the clock restarts and the search continues as a normal timed search
+    // - Only called by the main thread
+    [[nodiscard]] auto is_pondering() noexcept -> bool {
+        if (m_pondering && !m_external_ponder->load(std::memory_order_relaxed)) {
+            m_pondering = false;
+            m_start_time = clock_type::now();
+        }
+        return m_pondering;
+    }
+
+    [[nodiscard]] auto nodes() const noexcept -> std::uint64_t {
+        return m_nodes.load(std::memory_order_relaxed);
     }
 
-    auto update() noexcept -> void {
+    // Called by every search thread roughly every poll_frequency nodes
+    // - Node counts are summed across all search threads
+    // - Only the main thread reads the clock and the external stop flag
+    auto update(const bool main_thread, const std::uint64_t new_nodes) noexcept -> void {
+        m_nodes.fetch_add(new_nodes, std::memory_order_relaxed);
+
+        if (!main_thread) {
+            return;
+        }
+
+        if (m_external_stop.load(std::memory_order_relaxed)) {
+            m_stop = true;
+            return;
+        }
+
+        if (is_pondering()) {
+            return;
+        }
+
+        // Always finish the first iteration so there's a move to play
+        if (m_current_depth <= 1) {
+            return;
+        }
+
         switch (m_settings.type) {
             case SearchType::Time:
-                m_stop = m_stop || elapsed().count() >= m_target_time;
+                if (elapsed().count() >= m_target_time) {
+                    m_stop = true;
+                }
                 break;
             case SearchType::Depth:
-                m_stop = m_stop || m_current_depth > m_settings.depth;
                 break;
             case SearchType::Movetime:
-                m_stop = m_stop || elapsed().count() >= m_settings.movetime;
+                if (elapsed().count() >= m_settings.movetime) {
+                    m_stop = true;
+                }
                 break;
             case SearchType::Nodes:
+                if (nodes() >= m_settings.nodes) {
+                    m_stop = true;
+                }
                 break;
             case SearchType::Infinite:
                 break;
@@ -65,11 +126,17 @@ class SearchController {
     }
 
    private:
-    SearchSettings m_settings;
+    // The stop flag is read by every thread at every node and the node counter is written by every thread,
+    // so give each of them their own cache line
+    alignas(64) std::atomic<bool> m_stop = false;
+    alignas(64) std::atomic<std::uint64_t> m_nodes = 0;
+    alignas(64) SearchSettings m_settings;
     clock_type::time_point m_start_time;
     int m_current_depth = 0;
     int m_target_time = 0;
-    std::atomic<bool> &m_stop;
+    std::atomic<bool> &m_external_stop;
+    std::atomic<bool> *m_external_ponder = nullptr;
+    bool m_pondering = false;
 };
 
 }  // namespace swizzles::search
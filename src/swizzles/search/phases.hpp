@@ -0,0 +1,108 @@
+#ifndef SWIZZLES_SEARCH_PHASES_HPP
+#define SWIZZLES_SEARCH_PHASES_HPP
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <perf_counters.hpp>
+
+namespace swizzles::search {
+
+// Hardware counters are only attributed to search phases when built with -DSWIZZLES_PERF=ON
+// Reading the counters costs a system call per scope, so this is for investigations rather than play
+#ifdef SWIZZLES_PERF
+static constexpr bool phases_enabled = true;
+#else
+static constexpr bool phases_enabled = false;
+#endif
+
+enum class Phase : int
+{
+    Movegen = 0,
+    Eval,
+    TTProbe,
+    Qsearch,
+    Count,
+};
+
+static constexpr std::size_t num_phases = static_cast<std::size_t>(Phase::Count);
+
+// Counters are per thread, so each search thread opens its own
+[[nodiscard]] inline auto thread_counters() noexcept -> const perf::PerfCounters & {
+    thread_local const perf::PerfCounters counters;
+    return counters;
+}
+
+class Phases {
+   public:
+    constexpr auto add(const Phase phase, const perf::Counts &counts) noexcept -> void {
+        if constexpr (phases_enabled) {
+            m_counts[static_cast<std::size_t>(phase)] += counts;
+        }
+    }
+
+    [[nodiscard]] constexpr auto get(const Phase phase) const noexcept -> perf::Counts {
+        if constexpr (phases_enabled) {
+            return m_counts[static_cast<std::size_t>(phase)];
+        } else {
+            return {};
+        }
+    }
+
+    constexpr auto operator+=(const Phases &rhs) noexcept -> Phases & {
+        for (std::size_t i = 0; i < m_counts.size(); ++i) {
+            m_counts[i] += rhs.m_counts[i];
+        }
+        return *this;
+    }
+
+   private:
+    std::array<perf::Counts, phases_enabled ? num_phases : 0> m_counts = {};
+};
+
+// Attribute the counters between construction and destruction to a phase
+// Scopes can nest, qsearch includes the movegen and eval it does
+class PhaseScope {
+   public:
+    [[nodiscard]] PhaseScope(Phases &phases, const Phase phase) noexcept : m_phases(phases), m_phase(phase) {
+        if constexpr (phases_enabled) {
+            m_start = thread_counters().read();
+        }
+    }
+
+    PhaseScope(const PhaseScope &) = delete;
+    auto operator=(const PhaseScope &) -> PhaseScope & = delete;
+
+    ~PhaseScope() noexcept {
+        if constexpr (phases_enabled) {
+            m_phases.add(m_phase, thread_counters().read() - m_start);
+        }
+    }
+
+   private:
+    Phases &m_phases;
+    Phase m_phase;
+    perf::Counts m_start;
+};
+
+// Run func as part of a phase and return its result
+template <typename F>
+[[nodiscard]] auto in_phase(Phases &phases, const Phase phase, F &&func) noexcept {
+    const auto scope = PhaseScope(phases, phase);
+    return func();
+}
+
+// Print the phases as UCI info strings
+inline auto operator<<(std::ostream &os, const Phases &phases) noexcept -> std::ostream & {
+    constexpr std::array<const char *, num_phases> names = {"movegen", "eval", "tt probe", "qsearch"};
+    for (std::size_t i = 0; i < num_phases; ++i) {
+        os << "info string " << names[i] << " ";
+        perf::print_summary(os, thread_counters(), phases.get(Phase(i)));
+        os << "\n";
+    }
+    return os;
+}
+
+}  // namespace swizzles::search
+
+#endif
@@ -5,8 +5,10 @@
 
 namespace swizzles::search {
 
-[[nodiscard]] auto qsearch(const ThreadData &td, chess::Position &pos, int alpha, const int beta) noexcept -> int {
-    const auto stand_pat = eval::eval(pos);
+[[nodiscard]] auto qsearch(ThreadData &td, chess::Position &pos, int alpha, const int beta) noexcept -> int {
+    td.stats.inc(Stat::QsearchNodes);
+
+    const auto stand_pat = in_phase(td.phases, Phase::Eval, [&] { return eval::eval(pos); });
 
     if (stand_pat >= beta) {
         return beta;
@@ -16,17 +18,17 @@ namespace swizzles::search {
         alpha = stand_pat;
     }
 
-    auto moves = pos.captures();
+    auto moves = in_phase(td.phases, Phase::Movegen, [&] { return pos.captures(); });
     sort(moves, chess::Move(), td, pos.turn());
 
+    const auto info = moves.empty() ? chess::AttackInfo() : pos.legal_info();
     for (const auto move : moves) {
-        pos.makemove(move);
-
-        if (pos.is_attacked(pos.get_king(!pos.turn()), pos.turn())) {
-            pos.undomove();
+        if (!pos.is_legal(move, info)) {
             continue;
         }
 
+        pos.makemove(move);
+
         const auto score = -qsearch(td, pos, -beta, -alpha);
 
         pos.undomove();
@@ -3,6 +3,8 @@
 
 #include <chess/move.hpp>
 #include <cstdint>
+#include "phases.hpp"
+#include "stats.hpp"
 
 namespace swizzles::search {
 
@@ -15,6 +17,8 @@ struct Results {
     int eval = 0;
     std::uint64_t ms = 0;
     int tbhits = 0;
+    Stats stats;
+    Phases phases;
 };
 
 }  // namespace swizzles::search
@@ -1,12 +1,42 @@
 #include "root.hpp"
+#include <algorithm>
 #include <chess/position.hpp>
 #include <chrono>
 #include <thread>
 #include "controller.hpp"
 #include "search.hpp"
+#include "sort.hpp"
+#include "timeman.hpp"
 
 namespace swizzles::search {
 
+static constexpr int aspiration_min_depth = 4;
+static constexpr int aspiration_delta = 25;
+
+[[nodiscard]] auto get_root_moves(const ThreadData &td, const std::vector<chess::Move> &searchmoves) noexcept
+    -> RootMoves {
+    const auto &pos = td.pos;
+    const auto info = pos.legal_info();
+    auto moves = pos.movegen(info);
+
+    // Give the first iteration the same move ordering as the rest of the tree
+    const auto ttentry = td.tt->poll(pos.hash());
+    sort(moves, ttentry.move, td, pos.turn());
+
+    RootMoves root_moves;
+    for (const auto &move : moves) {
+        const auto is_searchmove = std::find(searchmoves.begin(), searchmoves.end(), move) != searchmoves.end();
+        if (!searchmoves.empty() && !is_searchmove) {
+            continue;
+        }
+
+        if (pos.is_legal(move, info)) {
+            root_moves.emplace_back(move);
+        }
+    }
+    return root_moves;
+}
+
 [[nodiscard]] auto get_nodes(const std::vector<ThreadData> &thread_data) noexcept -> std::uint64_t {
     std::uint64_t total = 0;
     for (const auto &data : thread_data) {
@@ -25,13 +55,25 @@ namespace swizzles::search {
 
 [[nodiscard]] auto root(const uci::UCIState &state, const SearchSettings settings, std::atomic<bool> &stop) noexcept
     -> Results {
-    auto controller = SearchController(settings, stop);
+    std::atomic<bool> ponder = false;
+    return root(state, settings, stop, ponder);
+}
+
+[[nodiscard]] auto root(const uci::UCIState &state,
+                        const SearchSettings settings,
+                        std::atomic<bool> &stop,
+                        std::atomic<bool> &ponder) noexcept -> Results {
+    auto controller = SearchController(settings, stop, ponder);
     controller.start();
 
     // Time strategy
+    auto timeman = TimeManager();
     if (settings.type == SearchType::Time) {
-        const auto time = state.pos.turn() == chess::Colour::White ? settings.wtime : settings.btime;
-        controller.set_max_time(time / 30);
+        const auto is_white = state.pos.turn() == chess::Colour::White;
+        const auto time = is_white ? settings.wtime : settings.btime;
+        const auto inc = is_white ? settings.winc : settings.binc;
+        timeman = TimeManager(allocate_time(time, inc, settings.movestogo));
+        controller.set_max_time(timeman.hard_limit());
     }
 
     auto results = Results();
@@ -42,16 +84,114 @@ namespace swizzles::search {
     }
 
     std::vector<std::thread> threads;
+    auto &main_data = thread_data[0];
+
+    // Restrict the root moves if we've been asked to, unless none of the searchmoves were legal
+    auto root_moves = get_root_moves(main_data, settings.searchmoves);
+    if (root_moves.empty() && !settings.searchmoves.empty()) {
+        root_moves = get_root_moves(main_data, {});
+    }
+
+    // Checkmate or stalemate
+    if (root_moves.empty()) {
+        return results;
+    }
+
+    const auto num_pvs = std::min(static_cast<std::size_t>(state.multipv.val), root_moves.size());
+
+    for (auto &data : thread_data) {
+        data.root_moves = root_moves;
+    }
+
+    const auto print_info = [&](const int depth,
+                                const std::size_t pv_idx,
+                                const int eval,
+                                const Bound bound,
+                                const PV &pv) {
+        const auto dt = controller.elapsed();
+        const auto nodes = get_nodes(thread_data);
+        const auto nps = dt.count() == 0 ? 0 : (1000 * nodes) / dt.count();
+        const auto hashfull = 0;
+        const auto tbhits = 0;
+        settings.info_printer(depth,
+                              get_seldepth(thread_data),
+                              static_cast<int>(pv_idx) + 1,
+                              eval,
+                              bound,
+                              dt.count(),
+                              nodes,
+                              nps,
+                              tbhits,
+                              hashfull,
+                              pv);
+    };
 
     for (int depth = 1; depth < max_depth; ++depth) {
         controller.set_depth(depth);
 
-        // Start the main search
-        const auto eval = swizzles::search::search(
-            thread_data[0], &thread_data[0].stack[0], thread_data[0].pos, -inf_score, inf_score, depth);
+        for (auto &rm : main_data.root_moves) {
+            rm.previous_score = rm.score;
+            rm.score = -inf_score;
+            rm.nodes = 0;
+        }
+
+        auto controller_stoppage = false;
+
+        // Each MultiPV line searches the root moves not already claimed by the lines before it
+        for (std::size_t pv_idx = 0; pv_idx < num_pvs; ++pv_idx) {
+            main_data.pv_idx = pv_idx;
+
+            // Aspiration windows around the previous iteration's score
+            const auto previous_score = main_data.root_moves[pv_idx].previous_score;
+            auto delta = aspiration_delta;
+            auto alpha = -inf_score;
+            auto beta = inf_score;
+            if (depth >= aspiration_min_depth && std::abs(previous_score) < mate_score - max_depth) {
+                alpha = std::max(previous_score - delta, -inf_score);
+                beta = std::min(previous_score + delta, inf_score);
+            }
+
+            auto eval = 0;
+            while (true) {
+                // Start the main search
+                eval = search_root(main_data, main_data.pos, alpha, beta, depth);
 
-        // Remember if the search controller stopped the search
-        const auto controller_stoppage = controller.should_stop();
+                if (controller.should_stop()) {
+                    break;
+                }
+
+                // Widen the window and search again
+                if (eval <= alpha) {
+                    print_info(depth, pv_idx, eval, Bound::Upper, main_data.stack[0].pv);
+                    alpha = std::max(eval - delta, -inf_score);
+                } else if (eval >= beta) {
+                    print_info(depth, pv_idx, eval, Bound::Lower, main_data.stack[0].pv);
+                    beta = std::min(eval + delta, inf_score);
+                } else {
+                    break;
+                }
+
+                delta *= 2;
+            }
+
+            // Remember if the search controller stopped the search
+            controller_stoppage = controller.should_stop();
+            if (controller_stoppage) {
+                break;
+            }
+
+            // Move the best move of this line into its slot
+            const auto &pv = main_data.stack[0].pv;
+            const auto first = main_data.root_moves.begin() + static_cast<std::ptrdiff_t>(pv_idx);
+            const auto found = std::find_if(first, main_data.root_moves.end(), [&pv](const RootMove &rm) {
+                return !pv.empty() && rm.move == pv[0];
+            });
+            if (found != main_data.root_moves.end()) {
+                found->score = eval;
+                found->pv = pv;
+                std::rotate(first, found, found + 1);
+            }
+        }
 
         // Tell helpers to stop
         controller.stop();
@@ -69,29 +209,51 @@ namespace swizzles::search {
             break;
         }
 
+        // Order the root moves for the next iteration
+        // - The MultiPV lines by score, later lines can occasionally score higher than earlier ones
+        // - The rest have no exact score, so try the ones with the largest subtrees first
+        std::stable_sort(main_data.root_moves.begin(), main_data.root_moves.end(), [](const auto &a, const auto &b) {
+            return a.score != b.score ? a.score > b.score : a.nodes > b.nodes;
+        });
+
         // Gather statistics
         const auto dt = controller.elapsed();
-        const auto bestmove = thread_data[0].stack[0].pv.size() > 0 ? thread_data[0].stack[0].pv[0] : chess::Move();
-        const auto ponder = thread_data[0].stack[0].pv.size() > 1 ? thread_data[0].stack[0].pv[1] : chess::Move();
+        const auto &best = main_data.root_moves[0];
+        const auto bestmove = best.move;
+        const auto ponder_move = best.pv.size() > 1 ? best.pv[1] : chess::Move();
+        const auto eval = best.score;
         const auto nodes = get_nodes(thread_data);
         const auto seldepth = get_seldepth(thread_data);
-        const auto nps = dt.count() == 0 ? 0 : (1000 * nodes) / dt.count();
-        const auto hashfull = 0;
         const auto tbhits = 0;
 
+        auto stats = Stats();
+        auto phases = Phases();
+        for (const auto &data : thread_data) {
+            stats += data.stats;
+            phases += data.phases;
+        }
+
         // Update search results
-        results = Results(bestmove, ponder, nodes, depth, seldepth, eval, dt.count(), tbhits);
+        results = Results(bestmove, ponder_move, nodes, depth, seldepth, eval, dt.count(), tbhits, stats, phases);
 
         // Print
-        settings.info_printer(depth,
-                              results.seldepth,
-                              eval,
-                              dt.count(),
-                              results.nodes,
-                              nps,
-                              results.tbhits,
-                              hashfull,
-                              thread_data[0].stack[0].pv);
+        for (std::size_t pv_idx = 0; pv_idx < num_pvs; ++pv_idx) {
+            const auto &rm = main_data.root_moves[pv_idx];
+            print_info(depth, pv_idx, rm.score, Bound::Exact, rm.pv);
+        }
+
+        // Decide whether there's enough time left for another iteration
+        if (settings.type == SearchType::Time) {
+            std::uint64_t root_nodes = 0;
+            for (const auto &rm : main_data.root_moves) {
+                root_nodes += rm.nodes;
+            }
+            const auto best_nodes = root_nodes == 0 ? 0 : (100 * best.nodes) / root_nodes;
+            timeman.update(bestmove, eval, static_cast<int>(best_nodes));
+            if (!controller.is_pondering() && timeman.should_stop(static_cast<int>(controller.elapsed().count()))) {
+                break;
+            }
+        }
     }
 
     return results;
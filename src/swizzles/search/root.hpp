@@ -10,6 +10,12 @@ namespace swizzles::search {
 [[nodiscard]] auto root(const uci::UCIState &state, const SearchSettings settings, std::atomic<bool> &stop) noexcept
     -> Results;
 
+// Search without time limits while ponder is set, then as a normal search once it's cleared
+[[nodiscard]] auto root(const uci::UCIState &state,
+                        const SearchSettings settings,
+                        std::atomic<bool> &stop,
+                        std::atomic<bool> &ponder) noexcept -> Results;
+
 }  // namespace swizzles::search
 
 #endif
@@ -0,0 +1,28 @@
+#ifndef SWIZZLES_SEARCH_ROOT_MOVE_HPP
+#define SWIZZLES_SEARCH_ROOT_MOVE_HPP
+
+#include <chess/move.hpp>
+#include <cstdint>
+#include <vector>
+#include "constants.hpp"
+#include "pv.hpp"
+
+namespace swizzles::search {
+
+struct RootMove {
+    [[nodiscard]] explicit RootMove(const chess::Move m) noexcept : move(m) {
+    }
+
+    chess::Move move;
+    int score = -inf_score;
+    int previous_score = -inf_score;
+    // Nodes spent searching this move during the current iteration
+    std::uint64_t nodes = 0;
+    PV pv;
+};
+
+using RootMoves = std::vector<RootMove>;
+
+}  // namespace swizzles::search
+
+#endif
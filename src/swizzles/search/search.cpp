@@ -1,4 +1,6 @@
 #include "search.hpp"
+#include <algorithm>
+#include <array>
 #include <chess/position.hpp>
 #include <limits>
 #include <tt.hpp>
@@ -14,24 +16,85 @@ namespace swizzles::search {
     return (piece_mask & pos.colour(pos.turn())).count() <= 2;
 }
 
-[[nodiscard]] auto reduction(const chess::Move move,
+// ln(x) for building tables at compile time
+[[nodiscard]] constexpr auto constexpr_log(double x) noexcept -> double {
+    // ln(x) = 2 * atanh((x - 1) / (x + 1)), which converges quickly for x in [1, 2)
+    const auto atanh_series = [](const double y) {
+        auto sum = 0.0;
+        auto term = y;
+        for (int i = 1; i < 64; i += 2) {
+            sum += term / i;
+            term *= y * y;
+        }
+        return 2.0 * sum;
+    };
+
+    const auto ln2 = atanh_series(1.0 / 3.0);
+    auto result = 0.0;
+    while (x >= 2.0) {
+        x /= 2.0;
+        result += ln2;
+    }
+    return result + atanh_series((x - 1.0) / (x + 1.0));
+}
+
+static_assert(constexpr_log(1.0) == 0.0);
+static_assert(constexpr_log(2.718281828459045) > 0.999999 && constexpr_log(2.718281828459045) < 1.000001);
+static_assert(constexpr_log(64.0) > 4.158883 && constexpr_log(64.0) < 4.158884);
+
+// History score above which a quiet move is reduced less
+static constexpr std::uint64_t history_threshold = 1ULL << 12;
+
+// Late move reductions indexed by depth and move number
+static constexpr auto lmr_table = []() {
+    std::array<std::array<int, 64>, 64> table = {};
+    for (int depth = 1; depth < 64; ++depth) {
+        for (int num = 1; num < 64; ++num) {
+            table[depth][num] = static_cast<int>(1.0 + constexpr_log(depth) * constexpr_log(num) / 2.0);
+        }
+    }
+    return table;
+}();
+
+static_assert(lmr_table[1][1] == 1);
+static_assert(lmr_table[3][5] == 1);
+static_assert(lmr_table[10][20] == 4);
+static_assert(lmr_table[63][63] > lmr_table[10][20]);
+
+[[nodiscard]] auto reduction(const ThreadData &td,
+                             const chess::Colour us,
+                             const chess::Move move,
                              const int depth,
                              const int legal_moves,
                              const bool in_check,
                              const bool gives_check,
-                             const bool is_root) noexcept -> int {
-    if (!is_root && !in_check && legal_moves > 4 && depth >= 3 && move.promo() == chess::PieceType::None &&
-        move.captured() == chess::PieceType::None && !gives_check) {
-        auto r = 1;
-        if (depth >= 6) {
-            r = 2;
-        }
-        if (legal_moves >= 20) {
-            r += 1;
-        }
-        return r;
+                             const bool is_pv) noexcept -> int {
+    if (in_check || legal_moves <= 3 || depth < 3 || move.promo() != chess::PieceType::None ||
+        move.captured() != chess::PieceType::None || gives_check) {
+        return 0;
+    }
+
+    auto r = lmr_table[std::min(depth, 63)][std::min(legal_moves, 63)];
+
+    // Reduce PV nodes less
+    if (is_pv) {
+        r--;
     }
-    return 0;
+
+    // Reduce moves that have caused cutoffs less
+    const auto history = td.history_score[chess::index(us)][chess::index(move.from())][chess::index(move.to())];
+    if (history >= history_threshold) {
+        r--;
+    }
+
+    // Always leave at least one ply to search
+    return std::clamp(r, 0, depth - 2);
+}
+
+auto update_pv(SearchStack *ss, const chess::Move move) noexcept -> void {
+    ss->pv.clear();
+    ss->pv.push_back(move);
+    ss->pv.insert(ss->pv.end(), (ss + 1)->pv.begin(), (ss + 1)->pv.end());
 }
 
 [[nodiscard]] auto search(ThreadData &td,
@@ -41,13 +104,24 @@ namespace swizzles::search {
                           int beta,
                           int depth) noexcept -> int {
     td.seldepth = std::max(td.seldepth, ss->ply);
-    const auto alpha_orig = alpha;
+    ss->pv.clear();
+    const auto is_pv = beta - alpha > 1;
+    // Extensions stop once a line is twice as long as the root depth so perpetual checks can't explode the tree
+    const auto can_extend = ss->ply < 2 * td.root_depth;
+
+    td.stats.inc(Stat::SearchNodes);
+    td.stats.inc(Stat::TTProbes);
+
+    const auto ttentry = in_phase(td.phases, Phase::TTProbe, [&] { return td.tt->poll(pos.hash()); });
+    if (ttentry.hash == pos.hash()) {
+        td.stats.inc(Stat::TTHits);
+    }
 
-    const auto ttentry = td.tt->poll(pos.hash());
     if (ttentry.hash == pos.hash() && ttentry.depth >= depth) {
         const auto eval = eval_from_tt(ttentry.eval, ss->ply);
 
         if (ttentry.flag == TTFlag::Exact) {
+            td.stats.inc(Stat::TTCutoffs);
             ss->pv.clear();
             ss->pv.push_back(ttentry.move);
             return eval;
@@ -58,40 +132,73 @@ namespace swizzles::search {
         }
 
         if (alpha >= beta) {
+            td.stats.inc(Stat::TTCutoffs);
             ss->pv.clear();
             ss->pv.push_back(ttentry.move);
             return eval;
         }
     }
 
-    const auto is_root = ss->ply == 0;
-    const auto in_check = pos.is_attacked(pos.get_kings(pos.turn()), !pos.turn());
+    // Most nodes never get as far as generating moves, so only work out the attack info if we do
+    const auto in_check = ss->attack_info ? ss->attack_info->in_check()
+                                          : pos.is_attacked(pos.get_kings(pos.turn()), !pos.turn());
 
-    if (in_check) {
+    if (in_check && can_extend) {
         depth++;
     }
 
     if (depth == 0 || ss->ply == max_depth) {
-        return qsearch(td, pos, alpha, beta);
+        return in_phase(td.phases, Phase::Qsearch, [&] { return qsearch(td, pos, alpha, beta); });
     }
 
     if (pos.halfmoves() >= 100) {
         return 0;
     }
 
-    if (const auto repeats = pos.num_repeats(); (is_root && repeats == 3) || (!is_root && repeats == 2)) {
+    if (pos.is_repetition()) {
         return 0;
     }
 
-    td.controller->update();
+    // A reversible move can repeat a position, so we can't do worse than a draw
+    if (alpha < 0 && pos.has_upcoming_repetition(ss->ply)) {
+        alpha = 0;
+        if (alpha >= beta) {
+            return alpha;
+        }
+    }
+
+    // Mate Distance Pruning
+    // - Even mating on the next move can't beat a shorter mate found elsewhere in the tree
+    alpha = std::max(alpha, -mate_score + ss->ply);
+    beta = std::min(beta, mate_score - ss->ply - 1);
+    if (alpha >= beta) {
+        return alpha;
+    }
+
+    // The TT, repetitions and mate distance can all raise alpha, and a score that fails low against the raised
+    // alpha is still only an upper bound
+    const auto alpha_orig = alpha;
+
+    if (td.nodes - td.polled_nodes >= SearchController::poll_frequency) {
+        td.controller->update(td.id == 0, td.nodes - td.polled_nodes);
+        td.polled_nodes = td.nodes;
+    }
 
     if (td.controller->should_stop()) {
         return 0;
     }
 
+    // Internal Iterative Reduction
+    // - Without a TT move our move ordering is poor, so search the node shallower and let the next iteration
+    //   search it properly with the move this search finds
+    const auto has_ttmove = ttentry.hash == pos.hash() && ttentry.move != chess::Move();
+    if (!has_ttmove && depth >= 4) {
+        depth--;
+    }
+
     // Static Null Move Pruning
-    if (!ss->null_move && !is_root && std::abs(beta) <= mate_score - max_depth) {
-        const auto static_eval = eval::eval(pos);
+    if (!ss->null_move && std::abs(beta) <= mate_score - max_depth) {
+        const auto static_eval = in_phase(td.phases, Phase::Eval, [&] { return eval::eval(pos); });
 
         if (depth == 1 && static_eval - 300 > beta) {
             return beta;
@@ -103,9 +210,11 @@ namespace swizzles::search {
     }
 
     // Null Move Pruning
-    if (!ss->null_move && depth >= 3 && !in_check && !is_root && !is_endgame(pos)) {
+    if (!ss->null_move && depth >= 3 && !in_check && !is_endgame(pos)) {
+        td.stats.inc(Stat::NullMoveTries);
         pos.makenull();
 
+        (ss + 1)->attack_info.reset();
         (ss + 1)->null_move = true;
         const auto score = -search(td, ss + 1, pos, -beta, -beta + 1, depth - 1 - 2);
         (ss + 1)->null_move = false;
@@ -115,6 +224,7 @@ namespace swizzles::search {
         ss->pv.clear();
 
         if (score >= beta) {
+            td.stats.inc(Stat::NullMoveCutoffs);
             return score;
         }
     }
@@ -122,26 +232,32 @@ namespace swizzles::search {
     auto legal_moves = 0;
     auto best_score = std::numeric_limits<int>::min();
     auto best_move = chess::Move();
-    auto moves = pos.movegen();
+    if (!ss->attack_info) {
+        ss->attack_info = pos.attack_info();
+    }
+    const auto &info = *ss->attack_info;
+    auto moves = in_phase(td.phases, Phase::Movegen, [&] { return pos.movegen(info); });
 
     sort(moves, ttentry.move, td, pos.turn());
 
     // Prob cut
-    if (!is_root && depth >= 5 && std::abs(beta) < mate_score - max_depth) {
+    if (depth >= 5 && std::abs(beta) < mate_score - max_depth) {
         const auto r_beta = std::min(mate_score - max_depth, beta + 100);
         for (const auto &move : moves) {
-            pos.makemove(move);
-
-            if (pos.is_attacked(pos.get_king(!pos.turn()), pos.turn())) {
-                pos.undomove();
+            if (!pos.is_legal(move, info)) {
                 continue;
             }
 
+            pos.makemove(move);
+            (ss + 1)->attack_info.reset();
+
+            td.stats.inc(Stat::ProbcutTries);
             const auto prob_cut_score = -search(td, ss + 1, pos, -r_beta, -r_beta + 1, depth - 1 - 3);
 
             pos.undomove();
 
             if (prob_cut_score >= r_beta) {
+                td.stats.inc(Stat::ProbcutCutoffs);
                 ss->pv.clear();
                 ss->pv.push_back(move);
                 return prob_cut_score;
@@ -150,13 +266,16 @@ namespace swizzles::search {
     }
 
     for (const auto &move : moves) {
-        pos.makemove(move);
-
-        if (pos.is_attacked(pos.get_king(!pos.turn()), pos.turn())) {
-            pos.undomove();
+        if (!pos.is_legal(move, info)) {
             continue;
         }
 
+        // Only LMR needs to know, which the first move never gets
+        const auto gives_check = legal_moves > 0 && pos.gives_check(move, info);
+
+        pos.makemove(move);
+        (ss + 1)->attack_info.reset();
+
         td.nodes++;
         legal_moves++;
 
@@ -167,11 +286,17 @@ namespace swizzles::search {
             score = -search(td, ss + 1, pos, -beta, -alpha, depth - 1);
         } else {
             // LMR
-            const auto gives_check = pos.is_attacked(pos.get_kings(pos.turn()), !pos.turn());
-            const auto r = reduction(move, depth, legal_moves, in_check, gives_check, is_root);
+            const auto r = reduction(td, !pos.turn(), move, depth, legal_moves, in_check, gives_check, is_pv);
+
+            if (r > 0) {
+                td.stats.inc(Stat::LMRSearches);
+            }
 
             score = -search(td, ss + 1, pos, -alpha - 1, -alpha, depth - 1 - r);
             if (score > alpha) {
+                if (r > 0) {
+                    td.stats.inc(Stat::LMRResearches);
+                }
                 score = -search(td, ss + 1, pos, -beta, -alpha, depth - 1);
             }
         }
@@ -181,12 +306,16 @@ namespace swizzles::search {
         if (score > best_score) {
             best_score = score;
             best_move = move;
-            ss->pv.clear();
-            ss->pv.push_back(move);
+            update_pv(ss, move);
         }
 
         alpha = std::max(alpha, score);
         if (alpha >= beta) {
+            td.stats.inc(Stat::BetaCutoffs);
+            if (legal_moves == 1) {
+                td.stats.inc(Stat::FirstMoveCutoffs);
+            }
+
             if (move.captured() == chess::PieceType::None && depth < 64) {
                 td.history_score[chess::index(pos.turn())][chess::index(move.from())][chess::index(move.to())] +=
                     1ULL << depth;
@@ -214,6 +343,100 @@ namespace swizzles::search {
     }
     new_ttentry.depth = depth;
     new_ttentry.move = best_move;
+    new_ttentry.hash = pos.hash();
+    td.tt->add(pos.hash(), new_ttentry);
+
+    return best_score;
+}
+
+[[nodiscard]] auto search_root(ThreadData &td, chess::Position &pos, int alpha, const int beta, int depth) noexcept
+    -> int {
+    auto *ss = &td.stack[0];
+    ss->pv.clear();
+    td.root_depth = depth;
+    const auto alpha_orig = alpha;
+    const auto &settings = td.controller->settings();
+    const auto in_check = pos.is_attacked(pos.get_kings(pos.turn()), !pos.turn());
+
+    if (in_check) {
+        depth++;
+    }
+
+    auto legal_moves = 0;
+    auto best_score = -inf_score;
+    auto best_move = chess::Move();
+
+    // The root moves are already legal and ordered by the previous iterations
+    // - Moves before pv_idx have been claimed by earlier MultiPV lines
+    for (auto i = td.pv_idx; i < td.root_moves.size(); ++i) {
+        auto &rm = td.root_moves[i];
+        const auto move = rm.move;
+        const auto nodes_before = td.nodes;
+
+        legal_moves++;
+
+        if (td.id == 0) {
+            const auto ms = static_cast<std::uint64_t>(td.controller->elapsed().count());
+            // Numbered over all the root moves, so lower MultiPV lines don't start again from 1
+            settings.currmove_printer(depth, move, static_cast<int>(i) + 1, ms);
+        }
+
+        pos.makemove(move);
+        (ss + 1)->attack_info.reset();
+        td.nodes++;
+
+        // Principal Variation Search
+        auto score = 0;
+        if (legal_moves == 1) {
+            score = -search(td, ss + 1, pos, -beta, -alpha, depth - 1);
+        } else {
+            score = -search(td, ss + 1, pos, -alpha - 1, -alpha, depth - 1);
+            if (score > alpha) {
+                score = -search(td, ss + 1, pos, -beta, -alpha, depth - 1);
+            }
+        }
+
+        pos.undomove();
+
+        rm.nodes += td.nodes - nodes_before;
+
+        if (td.controller->should_stop()) {
+            return 0;
+        }
+
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+            update_pv(ss, move);
+        }
+
+        alpha = std::max(alpha, score);
+        if (alpha >= beta) {
+            if (move.captured() == chess::PieceType::None && depth < 64) {
+                td.history_score[chess::index(pos.turn())][chess::index(move.from())][chess::index(move.to())] +=
+                    1ULL << depth;
+            }
+            break;
+        }
+    }
+
+    // Lower MultiPV lines exclude the best root moves, so don't let them overwrite the real result
+    if (td.pv_idx > 0) {
+        return best_score;
+    }
+
+    auto new_ttentry = TTEntry();
+    new_ttentry.eval = eval_to_tt(best_score, ss->ply);
+    if (best_score <= alpha_orig) {
+        new_ttentry.flag = TTFlag::Upper;
+    } else if (best_score >= beta) {
+        new_ttentry.flag = TTFlag::Lower;
+    } else {
+        new_ttentry.flag = TTFlag::Exact;
+    }
+    new_ttentry.depth = depth;
+    new_ttentry.move = best_move;
+    new_ttentry.hash = pos.hash();
     td.tt->add(pos.hash(), new_ttentry);
 
     return best_score;
@@ -38,6 +38,10 @@ namespace swizzles::search {
                           int beta,
                           int depth) noexcept -> int;
 
+// Searches the thread's root moves and records how many nodes each of them took
+[[nodiscard]] auto search_root(ThreadData &td, chess::Position &pos, int alpha, const int beta, int depth) noexcept
+    -> int;
+
 }  // namespace swizzles::search
 
 #endif
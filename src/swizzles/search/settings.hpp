@@ -4,6 +4,7 @@
 #include <chess/position.hpp>
 #include <cstdint>
 #include <functional>
+#include <vector>
 #include "pv.hpp"
 #include "results.hpp"
 
@@ -18,9 +19,18 @@ enum class SearchType : int
     Infinite,
 };
 
+enum class Bound : int
+{
+    Exact = 0,
+    Lower,
+    Upper,
+};
+
 using info_printer_type = std::function<void(const int depth,
                                              const int seldepth,
+                                             const int multipv,
                                              const int eval,
+                                             const Bound bound,
                                              const std::uint64_t ms,
                                              const std::uint64_t nodes,
                                              const std::uint64_t nps,
@@ -28,6 +38,9 @@ using info_printer_type = std::function<void(const int depth,
                                              const int hashfull,
                                              const PV &pv)>;
 
+using currmove_printer_type = std::function<void(
+    const int depth, const chess::Move move, const int currmovenumber, const std::uint64_t ms)>;
+
 struct SearchSettings {
     SearchType type = SearchType::Depth;
     int wtime = 0;
@@ -37,9 +50,14 @@ struct SearchSettings {
     int movestogo = 0;
     int depth = 1;
     int movetime = 0;
+    std::uint64_t nodes = 0;
+    // Only search these root moves, or all of them if empty
+    std::vector<chess::Move> searchmoves;
     info_printer_type info_printer = [](const int,
                                         const int,
                                         const int,
+                                        const int,
+                                        const Bound,
                                         const std::uint64_t,
                                         const std::uint64_t,
                                         const std::uint64_t,
@@ -47,6 +65,8 @@ struct SearchSettings {
                                         const int,
                                         const swizzles::search::PV &) {
     };
+    currmove_printer_type currmove_printer = [](const int, const chess::Move, const int, const std::uint64_t) {
+    };
 };
 
 }  // namespace swizzles::search
@@ -1,6 +1,8 @@
 #ifndef SWIZZLES_SEARCH_STACK_HPP
 #define SWIZZLES_SEARCH_STACK_HPP
 
+#include <chess/attack_info.hpp>
+#include <optional>
 #include "pv.hpp"
 
 namespace swizzles::search {
@@ -8,6 +10,8 @@ namespace swizzles::search {
 struct SearchStack {
     int ply = 0;
     bool null_move = false;
+    // Computed once per node
+    std::optional<chess::AttackInfo> attack_info;
     PV pv;
 };
 
@@ -0,0 +1,98 @@
+#ifndef SWIZZLES_SEARCH_STATS_HPP
+#define SWIZZLES_SEARCH_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace swizzles::search {
+
+// Search statistics are only collected when built with -DSWIZZLES_STATS=ON
+#ifdef SWIZZLES_STATS
+static constexpr bool stats_enabled = true;
+#else
+static constexpr bool stats_enabled = false;
+#endif
+
+enum class Stat : int
+{
+    SearchNodes = 0,
+    QsearchNodes,
+    TTProbes,
+    TTHits,
+    TTCutoffs,
+    BetaCutoffs,
+    FirstMoveCutoffs,
+    NullMoveTries,
+    NullMoveCutoffs,
+    ProbcutTries,
+    ProbcutCutoffs,
+    LMRSearches,
+    LMRResearches,
+    Count,
+};
+
+static constexpr std::size_t num_stats = static_cast<std::size_t>(Stat::Count);
+
+class Stats {
+   public:
+    // Compiles to nothing unless statistics are enabled
+    constexpr auto inc(const Stat stat) noexcept -> void {
+        if constexpr (stats_enabled) {
+            m_counts[static_cast<std::size_t>(stat)]++;
+        }
+    }
+
+    [[nodiscard]] constexpr auto get(const Stat stat) const noexcept -> std::uint64_t {
+        if constexpr (stats_enabled) {
+            return m_counts[static_cast<std::size_t>(stat)];
+        } else {
+            return 0;
+        }
+    }
+
+    constexpr auto operator+=(const Stats &rhs) noexcept -> Stats & {
+        for (std::size_t i = 0; i < m_counts.size(); ++i) {
+            m_counts[i] += rhs.m_counts[i];
+        }
+        return *this;
+    }
+
+   private:
+    std::array<std::uint64_t, stats_enabled ? num_stats : 0> m_counts = {};
+};
+
+// Print the statistics as UCI info strings
+inline auto operator<<(std::ostream &os, const Stats &stats) noexcept -> std::ostream & {
+    const auto rate = [&os, &stats](const std::string_view name, const Stat a, const Stat b) {
+        const auto n = stats.get(a);
+        const auto d = stats.get(b);
+        os << "info string " << name << " " << n << "/" << d;
+        if (d > 0) {
+            os << " (" << (100.0 * static_cast<double>(n)) / static_cast<double>(d) << "%)";
+        }
+        os << "\n";
+    };
+
+    const auto all_nodes = stats.get(Stat::SearchNodes) + stats.get(Stat::QsearchNodes);
+    os << "info string search nodes " << stats.get(Stat::SearchNodes) << "\n";
+    os << "info string qsearch nodes " << stats.get(Stat::QsearchNodes);
+    if (all_nodes > 0) {
+        os << " (" << (100.0 * static_cast<double>(stats.get(Stat::QsearchNodes))) / static_cast<double>(all_nodes)
+           << "%)";
+    }
+    os << "\n";
+    rate("tt hits", Stat::TTHits, Stat::TTProbes);
+    rate("tt cutoffs", Stat::TTCutoffs, Stat::TTProbes);
+    rate("first move cutoffs", Stat::FirstMoveCutoffs, Stat::BetaCutoffs);
+    rate("null move cutoffs", Stat::NullMoveCutoffs, Stat::NullMoveTries);
+    rate("probcut cutoffs", Stat::ProbcutCutoffs, Stat::ProbcutTries);
+    rate("lmr researches", Stat::LMRResearches, Stat::LMRSearches);
+    return os;
+}
+
+}  // namespace swizzles::search
+
+#endif
@@ -9,7 +9,10 @@
 #include "../ttentry.hpp"
 #include "constants.hpp"
 #include "controller.hpp"
+#include "phases.hpp"
+#include "root_move.hpp"
 #include "stack.hpp"
+#include "stats.hpp"
 
 namespace swizzles::search {
 
@@ -29,10 +32,17 @@ struct ThreadData {
 
     int id = 0;
     std::uint64_t nodes = 0;
+    std::uint64_t polled_nodes = 0;
     int seldepth = 0;
+    int root_depth = 0;
+    Stats stats;
+    Phases phases;
     int tbhits = 0;
     std::array<SearchStack, max_depth + 1> stack;
     std::uint64_t history_score[2][64][64] = {};
+    // Root moves before pv_idx have been claimed by earlier MultiPV lines
+    RootMoves root_moves;
+    std::size_t pv_idx = 0;
     SearchController *controller = nullptr;
     chess::Position pos;
     std::shared_ptr<TT<TTEntry>> tt;
@@ -0,0 +1,49 @@
+#include "timeman.hpp"
+#include <algorithm>
+#include <array>
+
+namespace swizzles::search {
+
+[[nodiscard]] auto allocate_time(const int time, const int inc, const int movestogo) noexcept -> TimeLimits {
+    const auto available = std::max(1, time - move_overhead);
+    // Assume sudden death games last another 30 moves
+    const auto mtg = movestogo > 0 ? std::min(movestogo, 30) : 30;
+    const auto base = available / mtg + (3 * inc) / 4;
+
+    auto limits = TimeLimits();
+    limits.hard = std::min(3 * base, (available * 8) / 10);
+    limits.soft = std::min(base, limits.hard);
+    return limits;
+}
+
+auto TimeManager::update(const chess::Move bestmove, const int eval, const int best_nodes) noexcept -> void {
+    if (m_iterations > 0 && bestmove == m_bestmove) {
+        m_stability++;
+    } else {
+        m_stability = 0;
+    }
+
+    m_score_drop = m_iterations > 0 ? std::max(0, m_eval - eval) : 0;
+    m_bestmove = bestmove;
+    m_eval = eval;
+    m_best_nodes = std::clamp(best_nodes, 0, 100);
+    m_iterations++;
+}
+
+[[nodiscard]] auto TimeManager::soft_limit() const noexcept -> int {
+    // Spend more time when the best move keeps changing and less once it has settled
+    constexpr std::array<int, 5> stability_scale = {180, 130, 100, 85, 75};
+    const auto stability = stability_scale[std::min(m_stability, 4)];
+
+    // Spend more time when the score drops between iterations
+    const auto score_drop = 100 + std::min(m_score_drop, 100);
+
+    // Spend less time when the best move needed most of the effort to refute the alternatives
+    const auto best_nodes = 150 - m_best_nodes;
+
+    const auto scaled =
+        (static_cast<long long>(m_limits.soft) * stability * score_drop * best_nodes) / (100 * 100 * 100);
+    return static_cast<int>(std::min(scaled, static_cast<long long>(m_limits.hard)));
+}
+
+}  // namespace swizzles::search
@@ -0,0 +1,54 @@
+#ifndef SWIZZLES_SEARCH_TIMEMAN_HPP
+#define SWIZZLES_SEARCH_TIMEMAN_HPP
+
+#include <chess/move.hpp>
+
+namespace swizzles::search {
+
+// Time reserved for communication delays between the engine and the GUI
+static constexpr int move_overhead = 20;
+
+struct TimeLimits {
+    // Don't start a new iteration once this much time has been used
+    int soft = 0;
+    // Abort the search once this much time has been used
+    int hard = 0;
+};
+
+[[nodiscard]] auto allocate_time(const int time, const int inc, const int movestogo) noexcept -> TimeLimits;
+
+class TimeManager {
+   public:
+    [[nodiscard]] TimeManager() noexcept = default;
+
+    [[nodiscard]] explicit TimeManager(const TimeLimits limits) noexcept : m_limits(limits) {
+    }
+
+    // Called after every completed iteration
+    // - best_nodes is the percentage of the iteration's root nodes spent on the best move
+    auto update(const chess::Move bestmove, const int eval, const int best_nodes) noexcept -> void;
+
+    // The soft limit adjusted for best move stability, score changes and the best move's share of the nodes
+    [[nodiscard]] auto soft_limit() const noexcept -> int;
+
+    [[nodiscard]] auto hard_limit() const noexcept -> int {
+        return m_limits.hard;
+    }
+
+    [[nodiscard]] auto should_stop(const int elapsed) const noexcept -> bool {
+        return elapsed >= soft_limit();
+    }
+
+   private:
+    TimeLimits m_limits;
+    chess::Move m_bestmove;
+    int m_stability = 0;
+    int m_eval = 0;
+    int m_score_drop = 0;
+    int m_best_nodes = 50;
+    int m_iterations = 0;
+};
+
+}  // namespace swizzles::search
+
+#endif
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <cstdint>
 #include <iostream>
 #include <thread>
@@ -11,9 +12,12 @@ namespace swizzles::uci {
 
 std::thread search_thread;
 std::atomic<bool> search_stop = false;
+std::atomic<bool> search_ponder = false;
 auto uci_info_printer = [](const int depth,
                            const int seldepth,
+                           const int multipv,
                            const int eval,
+                           const search::Bound bound,
                            const std::uint64_t ms,
                            const std::uint64_t nodes,
                            const std::uint64_t nps,
@@ -23,7 +27,13 @@ auto uci_info_printer = [](const int depth,
     std::cout << "info";
     std::cout << " depth " << depth;
     std::cout << " seldepth " << seldepth;
+    std::cout << " multipv " << multipv;
     std::cout << " score cp " << eval;
+    if (bound == search::Bound::Lower) {
+        std::cout << " lowerbound";
+    } else if (bound == search::Bound::Upper) {
+        std::cout << " upperbound";
+    }
     std::cout << " time " << ms;
     std::cout << " nodes " << nodes;
     std::cout << " nps " << nps;
@@ -38,12 +48,31 @@ auto uci_info_printer = [](const int depth,
     std::cout << std::endl;
 };
 
+// Only report the move being searched once the search has been running for a while
+auto uci_currmove_printer = [](const int depth,
+                               const chess::Move move,
+                               const int currmovenumber,
+                               const std::uint64_t ms) {
+    if (ms < 3000) {
+        return;
+    }
+    std::cout << "info depth " << depth;
+    std::cout << " currmove " << move;
+    std::cout << " currmovenumber " << currmovenumber;
+    std::cout << std::endl;
+};
+
 auto stop() noexcept -> void {
     search_stop = true;
     if (search_thread.joinable()) {
         search_thread.join();
     }
     search_stop = false;
+    search_ponder = false;
+}
+
+auto ponderhit() noexcept -> void {
+    search_ponder = false;
 }
 
 auto go(std::stringstream &ss, const UCIState &state) noexcept -> void {
@@ -52,10 +81,24 @@ auto go(std::stringstream &ss, const UCIState &state) noexcept -> void {
     // Search settings
     auto settings = search::SearchSettings();
     settings.info_printer = uci_info_printer;
+    settings.currmove_printer = uci_currmove_printer;
+
+    // Moves following "searchmoves" are collected until the next keyword
+    bool parsing_searchmoves = false;
 
     while (!ss.eof()) {
         std::string word;
         ss >> word;
+
+        if (parsing_searchmoves) {
+            const auto move = parse_move(state.pos, word);
+            if (move != chess::Move()) {
+                settings.searchmoves.push_back(move);
+                continue;
+            }
+            parsing_searchmoves = false;
+        }
+
         if (word == "wtime") {
             ss >> word;
             settings.type = search::SearchType::Time;
@@ -81,20 +124,34 @@ auto go(std::stringstream &ss, const UCIState &state) noexcept -> void {
             settings.type = search::SearchType::Movetime;
             settings.movetime = std::stoi(word);
         } else if (word == "nodes") {
-            // ss >> word;
-            // settings.type = search::SearchType::Nodes;
-            // settings.nodes = std::stoi(word);
+            ss >> word;
+            settings.type = search::SearchType::Nodes;
+            settings.nodes = std::stoull(word);
         } else if (word == "movestogo") {
             ss >> word;
             settings.movestogo = std::stoi(word);
         } else if (word == "infinite") {
             settings.type = search::SearchType::Infinite;
+        } else if (word == "ponder") {
+            search_ponder = true;
+        } else if (word == "searchmoves") {
+            parsing_searchmoves = true;
         }
     }
 
     search_thread = std::thread([state, settings]() {
-        const auto results = search::root(state, settings, search_stop);
-        std::cout << "bestmove " << results.bestmove << std::endl;
+        const auto results = search::root(state, settings, search_stop, search_ponder);
+
+        // The bestmove can't be sent until the GUI leaves ponder mode
+        while (search_ponder && !search_stop) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::cout << "bestmove " << results.bestmove;
+        if (results.ponder != chess::Move()) {
+            std::cout << " ponder " << results.ponder;
+        }
+        std::cout << std::endl;
     });
 }
 
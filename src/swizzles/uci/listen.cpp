@@ -1,7 +1,10 @@
+#include <chess/cpu.hpp>
+#include <chess/magic.hpp>
 #include <chess/position.hpp>
 #include <iostream>
 #include <sstream>
 #include <tt.hpp>
+#include "../eval/eval.hpp"
 #include "../settings.hpp"
 #include "../ttentry.hpp"
 #include "state.hpp"
@@ -26,8 +29,15 @@ auto listen() noexcept -> void {
 
     // Print options
     std::cout << "option name UCI_Chess960 type check default false\n";
+    std::cout << "option name Ponder type check default false\n";
     std::cout << state.hash << "\n";
     std::cout << state.threads << "\n";
+    std::cout << state.multipv << "\n";
+
+    // Report which code paths were picked for this CPU
+    std::cout << "info string cpu " << chess::cpu::to_string(chess::cpu::features());
+    std::cout << " eval " << eval::target();
+    std::cout << " sliders " << chess::magic::backend() << std::endl;
 
     // Reply to "uci"
     std::cout << "uciok" << std::endl;
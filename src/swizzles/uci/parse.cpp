@@ -22,6 +22,8 @@ auto parse(std::stringstream &ss, UCIState &state) noexcept -> bool {
             go(ss, state);
         } else if (word == "stop") {
             stop();
+        } else if (word == "ponderhit") {
+            ponderhit();
         } else if (word == "quit") {
             return true;
         }
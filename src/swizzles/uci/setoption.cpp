@@ -40,7 +40,10 @@ auto setoption(std::stringstream &ss, UCIState &state) noexcept -> void {
         state.hash.val = clamp(state.hash.min, state.hash.max, std::stoi(value));
     } else if (name == "Threads") {
         state.threads.val = clamp(state.threads.min, state.threads.max, std::stoi(value));
+    } else if (name == "MultiPV") {
+        state.multipv.val = clamp(state.multipv.min, state.multipv.max, std::stoi(value));
     } else if (name == "UCI_Chess960") {
+    } else if (name == "Ponder") {
     }
 }
 
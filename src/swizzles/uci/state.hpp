@@ -14,6 +14,7 @@ struct UCIState {
     std::shared_ptr<TT<TTEntry>> tt;
     settings::Spin hash = settings::Spin("Hash", 1, 128, 1);
     settings::Spin threads = settings::Spin("Threads", 1, 4, 1);
+    settings::Spin multipv = settings::Spin("MultiPV", 1, 64, 1);
 };
 
 }  // namespace swizzles::uci
@@ -2,6 +2,7 @@
 #define SWIZZLES_UCI_HPP
 
 #include <sstream>
+#include <string>
 #include "state.hpp"
 
 namespace swizzles::uci {
@@ -12,8 +13,10 @@ auto position(std::stringstream &ss, UCIState &state) noexcept -> void;
 auto setoption(std::stringstream &ss, UCIState &state) noexcept -> void;
 auto ucinewgame(UCIState &state) noexcept -> void;
 auto moves(std::stringstream &ss, UCIState &state) noexcept -> void;
+[[nodiscard]] auto parse_move(const chess::Position &pos, const std::string &word) noexcept -> chess::Move;
 auto go(std::stringstream &ss, const UCIState &state) noexcept -> void;
 auto stop() noexcept -> void;
+auto ponderhit() noexcept -> void;
 
 }  // namespace swizzles::uci
 
@@ -0,0 +1,22 @@
+#include <doctest/doctest.h>
+#include <chess/cpu.hpp>
+#include <chess/magic.hpp>
+
+TEST_CASE("CPU features") {
+    const auto &features = chess::cpu::features();
+
+    // Anything we were compiled to use must be there, or we wouldn't be running
+#ifdef __POPCNT__
+    REQUIRE(features.popcnt);
+#endif
+#ifdef __BMI2__
+    REQUIRE(features.bmi2);
+#endif
+#ifdef __AVX2__
+    REQUIRE(features.avx2);
+#endif
+
+    REQUIRE(&features == &chess::cpu::features());
+    REQUIRE(!chess::cpu::to_string(features).empty());
+    REQUIRE(!chess::magic::backend().empty());
+}
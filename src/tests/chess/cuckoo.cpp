@@ -0,0 +1,134 @@
+#include <doctest/doctest.h>
+#include <array>
+#include <chess/cuckoo.hpp>
+#include <chess/position.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST_SUITE_BEGIN("Cuckoo");
+
+namespace {
+
+auto play(chess::Position &pos, const std::string &movestrs) -> void {
+    std::stringstream ss(movestrs);
+    std::string movestr;
+    while (ss >> movestr) {
+        for (const auto move : pos.movegen()) {
+            if (static_cast<std::string>(move) == movestr) {
+                pos.makemove(move);
+                break;
+            }
+        }
+    }
+}
+
+// Try every move and look for the resulting position in the history
+[[nodiscard]] auto brute_force(chess::Position &pos, const std::vector<chess::zobrist::hash_type> &hashes) -> bool {
+    for (const auto move : pos.movegen()) {
+        pos.makemove(move);
+        // Positions since the last irreversible move with the same side to move as after the move
+        // - hashes.size() - i is i plies before the move was made
+        for (std::size_t i = 3; i < pos.halfmoves() && i <= hashes.size(); i += 2) {
+            if (hashes[hashes.size() - i] == pos.hash()) {
+                pos.undomove();
+                return true;
+            }
+        }
+        pos.undomove();
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST_CASE("Cuckoo - Table") {
+    // 2 colours of knight, bishop, rook, queen and king moves between unordered pairs of squares
+    REQUIRE(chess::cuckoo::num_entries() == 3668);
+}
+
+TEST_CASE("Cuckoo - Between") {
+    using chess::Square;
+    REQUIRE(chess::cuckoo::between(Square::A1, Square::A2).empty());
+    REQUIRE(chess::cuckoo::between(Square::A1, Square::B3).empty());
+    REQUIRE(chess::cuckoo::between(Square::A1, Square::A3) == chess::Bitboard(Square::A2));
+    REQUIRE(chess::cuckoo::between(Square::A1, Square::C3) == chess::Bitboard(Square::B2));
+    REQUIRE(chess::cuckoo::between(Square::H8, Square::A1).count() == 6);
+    REQUIRE(chess::cuckoo::between(Square::H1, Square::A1).count() == 6);
+}
+
+TEST_CASE("Position::has_upcoming_repetition()") {
+    using tuple_type = std::tuple<std::string, std::string, bool>;
+
+    const std::array<tuple_type, 8> tests = {{
+        {"startpos", "", false},
+        {"startpos", "g1f3 g8f6", false},
+        {"startpos", "g1f3 g8f6 f3g1", true},
+        {"startpos", "g1f3 g8f6 f3g1 f6g8", true},
+        {"startpos", "g1f3 g8f6 f3g1 f6g8 b1c3", false},
+        // Pawn moves can't be undone
+        {"startpos", "g1f3 g8f6 f3g1 e7e6", false},
+        // The rook can't return through the knight
+        {"4k3/8/8/8/8/8/8/R3K3 w - - 0 1", "a1a3 e8d8 b1b2", false},
+        {"4k3/8/8/8/8/8/8/R3K3 w - - 0 1", "a1a3 e8d8 e1f1 d8e8", true},
+    }};
+
+    for (const auto &[fen, movestrs, expected] : tests) {
+        INFO("FEN: ", fen);
+        INFO("Moves: ", movestrs);
+        auto pos = chess::Position(fen);
+        play(pos, movestrs);
+        REQUIRE(pos.has_upcoming_repetition(100) == expected);
+    }
+}
+
+TEST_CASE("Position::has_upcoming_repetition() - Ply") {
+    auto pos = chess::Position("startpos");
+    play(pos, "g1f3 g8f6 f3g1");
+    // The position to repeat is 3 plies ago, so it has to be within the search tree
+    REQUIRE(!pos.has_upcoming_repetition(3));
+    REQUIRE(pos.has_upcoming_repetition(4));
+}
+
+TEST_CASE("Position::has_upcoming_repetition() - Brute force") {
+    const std::array<std::string, 3> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        INFO("FEN: ", fen);
+        auto pos = chess::Position(fen);
+        std::vector<chess::zobrist::hash_type> hashes;
+        std::uint64_t seed = 0x12345678;
+
+        // Wander around with reversible moves so repetitions are likely
+        for (int ply = 0; ply < 300; ++ply) {
+            INFO("Ply: ", ply);
+            REQUIRE(pos.has_upcoming_repetition(1000) == brute_force(pos, hashes));
+
+            std::vector<chess::Move> candidates;
+            for (const auto move : pos.movegen()) {
+                pos.makemove(move);
+                const auto legal = !pos.is_attacked(pos.get_king(!pos.turn()), pos.turn());
+                pos.undomove();
+                if (legal && move.piece() != chess::PieceType::Pawn &&
+                    move.captured() == chess::PieceType::None) {
+                    candidates.push_back(move);
+                }
+            }
+            if (candidates.empty()) {
+                break;
+            }
+
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            hashes.push_back(pos.hash());
+            pos.makemove(candidates[(seed >> 33) % candidates.size()]);
+        }
+    }
+}
+
+TEST_SUITE_END();
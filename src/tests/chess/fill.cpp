@@ -0,0 +1,47 @@
+#include <doctest/doctest.h>
+#include <chess/bitboard.hpp>
+#include <chess/fill.hpp>
+#include <chess/magic.hpp>
+#include <cstdint>
+
+TEST_CASE("Kogge-Stone fills") {
+    std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+    const auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    for (int i = 0; i < 1000; ++i) {
+        const auto occupied = chess::Bitboard(next() & next());
+        const auto empty = ~occupied;
+        const auto rooks = chess::Bitboard(next() & next() & next()) & occupied;
+        const auto bishops = chess::Bitboard(next() & next() & next()) & occupied;
+
+        // The union of the lookups for each piece
+        auto rook_expected = chess::Bitboard();
+        for (const auto sq : rooks) {
+            rook_expected |= chess::magic::rook_moves(sq, occupied);
+        }
+        auto bishop_expected = chess::Bitboard();
+        for (const auto sq : bishops) {
+            bishop_expected |= chess::magic::bishop_moves(sq, occupied);
+        }
+
+        INFO("Occupied: ", occupied.data());
+        REQUIRE(chess::fill::rook_scalar(rooks, empty) == rook_expected);
+        REQUIRE(chess::fill::bishop_scalar(bishops, empty) == bishop_expected);
+        // Vector kernels only exist when the target enables them
+#ifdef __AVX2__
+        REQUIRE(chess::fill::rook_avx2(rooks, empty) == rook_expected);
+        REQUIRE(chess::fill::bishop_avx2(bishops, empty) == bishop_expected);
+#endif
+#ifdef __AVX512F__
+        REQUIRE(chess::fill::sliders_avx512(rooks, bishops, empty) == (rook_expected | bishop_expected));
+#endif
+        REQUIRE(chess::fill::rook_attacks(rooks, empty) == rook_expected);
+        REQUIRE(chess::fill::bishop_attacks(bishops, empty) == bishop_expected);
+        REQUIRE(chess::fill::slider_attacks(rooks, bishops, empty) == (rook_expected | bishop_expected));
+    }
+}
@@ -0,0 +1,57 @@
+#include <doctest/doctest.h>
+#include <array>
+#include <chess/position.hpp>
+#include <string>
+
+static auto check_gives_check(chess::Position &pos, const std::size_t depth) noexcept -> void {
+    const auto info = pos.attack_info();
+
+    for (const auto &move : pos.movegen(info)) {
+        if (!pos.is_legal(move, info)) {
+            continue;
+        }
+
+        const auto gives_check = pos.gives_check(move, info);
+
+        pos.makemove<false>(move);
+        const auto expected = pos.is_attacked(pos.get_king(pos.turn()), !pos.turn());
+
+        if (depth > 1) {
+            check_gives_check(pos, depth - 1);
+        }
+
+        pos.undomove();
+
+        INFO("FEN: ", pos.get_fen(true));
+        INFO("Move: ", move);
+        REQUIRE(gives_check == expected);
+    }
+}
+
+TEST_CASE("gives_check") {
+    const std::array<std::string, 14> fens = {
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        // Discovered checks from each kind of slider
+        "4k3/8/4N3/8/1B6/8/4R3/4K3 w - - 0 1",
+        "1k6/8/8/8/8/2n5/1P6/1Q4K1 w - - 0 1",
+        // En passant uncovering a check along the rank
+        "8/8/8/r2Pp2K/8/8/8/k7 w - e6 0 2",
+        "8/8/8/K2Pp2r/8/8/8/7k w - e6 0 2",
+        // Promotions, including one whose line to the king passes the square the pawn left
+        "k7/P7/8/8/8/8/8/K7 w - - 0 1",
+        "1r5k/P7/8/8/8/8/8/K7 w - - 0 1",
+        "3k4/1P6/8/8/8/8/8/4K3 w - - 0 1",
+        // Castling with the rook giving check
+        "5k2/8/8/8/8/8/8/4K2R w K - 0 1",
+        "3k4/8/8/8/8/8/8/1R2K3 w B - 0 1",
+    };
+
+    for (const auto &fen : fens) {
+        auto pos = chess::Position(fen);
+        check_gives_check(pos, 3);
+    }
+}
@@ -0,0 +1,88 @@
+#include <doctest/doctest.h>
+#include <array>
+#include <chess/position.hpp>
+#include <string>
+#include <tuple>
+
+static auto check_legality(chess::Position &pos, const std::size_t depth) noexcept -> void {
+    const auto info = pos.legal_info();
+    REQUIRE(info.in_check() == pos.is_attacked(pos.get_king(pos.turn()), !pos.turn()));
+
+    for (const auto &move : pos.movegen(info)) {
+        const auto is_legal = pos.is_legal(move, info);
+
+        pos.makemove<false>(move);
+        const auto expected = !pos.is_attacked(pos.get_king(!pos.turn()), pos.turn());
+
+        if (expected && depth > 1) {
+            check_legality(pos, depth - 1);
+        }
+
+        pos.undomove();
+
+        INFO("FEN: ", pos.get_fen(true));
+        INFO("Move: ", move);
+        REQUIRE(is_legal == expected);
+    }
+}
+
+TEST_CASE("Attack info") {
+    using tuple_type = std::tuple<std::string, chess::Bitboard, chess::Bitboard>;
+    const std::array<tuple_type, 5> tests = {{
+        {"startpos", chess::Bitboard(), chess::Bitboard()},
+        {"4r1k1/8/8/8/8/8/4B3/4K3 w - - 0 1", chess::Bitboard(), chess::Bitboard(chess::Square::E2)},
+        {"4r1k1/8/8/8/8/4N3/4B3/4K3 w - - 0 1", chess::Bitboard(), chess::Bitboard()},
+        {"4r1k1/8/8/8/8/8/8/4K3 w - - 0 1", chess::Bitboard(chess::Square::E8), chess::Bitboard()},
+        {"6k1/8/8/b7/8/3n4/8/4K3 w - - 0 1",
+         chess::Bitboard(chess::Square::A5) | chess::Bitboard(chess::Square::D3),
+         chess::Bitboard()},
+    }};
+
+    for (const auto &[fen, checkers, pinned] : tests) {
+        INFO("FEN: ", fen);
+        const auto pos = chess::Position(fen);
+        const auto info = pos.attack_info();
+        REQUIRE(info.checkers == checkers);
+        REQUIRE(info.pinned == pinned);
+
+        // legal_info() leaves out only what gives_check() needs
+        const auto legal = pos.legal_info();
+        REQUIRE(legal.checkers == info.checkers);
+        REQUIRE(legal.pinned == info.pinned);
+        REQUIRE(legal.threats == info.threats);
+    }
+
+    // Their pawns and pieces attack all of ranks 6 and 7, and rank 8 apart from the corners
+    REQUIRE(chess::Position("startpos").attack_info().threats == chess::Bitboard(0x7EFFFF0000000000ULL));
+    // The rook sees through our king
+    const auto info = chess::Position("4r1k1/8/8/8/8/8/4K3/8 w - - 0 1").attack_info();
+    REQUIRE(!(info.threats & chess::Bitboard(chess::Square::E1)).empty());
+}
+
+TEST_CASE("is_legal") {
+    const std::array<std::string, 14> fens = {
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        // En passant that would expose the king along the rank
+        "8/8/8/K1pP3r/8/8/8/7k w - c6 0 2",
+        // En passant out of a check by the double pushed pawn
+        "8/8/8/2pP4/1K6/8/8/7k w - c6 0 2",
+        // Pins along each kind of line
+        "7k/8/3q4/8/1b3n2/2PPP3/r1NKB2r/8 w - - 0 1",
+        "4k3/4r3/8/8/8/8/4Q3/4K3 w - - 0 1",
+        // Chess960 castling where the rook shields the king's destination
+        "1k6/8/8/8/8/8/8/qR2K3 w B - 0 1",
+        "bqnb1rkr/pp3ppp/3ppn2/2p5/5P2/P2P4/NPP1P1PP/BQ1BNRKR w HFhf - 2 9",
+        "2r3kr/8/8/8/8/8/8/3RKR2 w FDhc - 0 1",
+        "1r2k1r1/8/8/8/8/8/8/1R2K1R1 w GBgb - 0 1",
+        "rr3k2/8/8/8/8/8/8/RR3K2 w Bb - 0 1",
+    };
+
+    for (const auto &fen : fens) {
+        auto pos = chess::Position(fen);
+        check_legality(pos, 3);
+    }
+}
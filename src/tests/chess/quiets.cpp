@@ -0,0 +1,54 @@
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <array>
+#include <chess/position.hpp>
+#include <string>
+#include <vector>
+
+// Staged generation has to find the same moves as movegen(), split between captures() and quiets()
+static auto check_stages(chess::Position &pos, const std::size_t depth) noexcept -> void {
+    const auto moves = pos.movegen();
+    const auto captures = pos.captures();
+    const auto quiets = pos.quiets();
+
+    INFO("FEN: ", pos.get_fen(true));
+    REQUIRE(captures.size() + quiets.size() == moves.size());
+
+    auto staged = std::vector<chess::Move>(captures.begin(), captures.end());
+    staged.insert(staged.end(), quiets.begin(), quiets.end());
+    REQUIRE(std::is_permutation(staged.begin(), staged.end(), moves.begin(), moves.end()));
+
+    for (const auto &move : quiets) {
+        REQUIRE(move.captured() == chess::PieceType::None);
+    }
+
+    if (depth == 0) {
+        return;
+    }
+
+    for (const auto &move : moves) {
+        pos.makemove<false>(move);
+        if (!pos.is_attacked(pos.get_king(!pos.turn()), pos.turn())) {
+            check_stages(pos, depth - 1);
+        }
+        pos.undomove();
+    }
+}
+
+TEST_CASE("Staged generation") {
+    const std::array<std::string, 8> fens = {
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r3k2r/2P3P1/8/8/8/8/2p3p1/R3K2R b KQkq - 0 1",
+        "4k3/8/8/8/3pPp2/8/8/4K3 b - e3 0 1",
+        "bqnb1rkr/pp3ppp/3ppn2/2p5/5P2/P2P4/NPP1P1PP/BQ1BNRKR w HFhf - 2 9",
+    };
+
+    for (const auto &fen : fens) {
+        auto pos = chess::Position(fen);
+        check_stages(pos, 2);
+    }
+}
@@ -0,0 +1,44 @@
+#include <doctest/doctest.h>
+#include <chess/bitboard.hpp>
+#include <chess/magic.hpp>
+#include <chess/square.hpp>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("Slider backends") {
+    // Random occupancies of varying density
+    std::vector<std::uint64_t> occupancies = {0ULL, ~0ULL};
+    std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 1000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const auto a = state;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        occupancies.push_back(i % 2 ? a & state : a | state);
+    }
+
+    for (const auto occ : occupancies) {
+        for (int i = 0; i < 64; ++i) {
+            const auto sq = chess::Square(i);
+            const auto bb = chess::Bitboard(occ);
+            const auto magic_bishop = chess::magic::magic_bishop_moves(sq, bb);
+            const auto magic_rook = chess::magic::magic_rook_moves(sq, bb);
+
+            // Whichever backend is in use
+            REQUIRE(chess::magic::bishop_moves(sq, bb) == magic_bishop);
+            REQUIRE(chess::magic::rook_moves(sq, bb) == magic_rook);
+
+            if (chess::magic::pext_supported()) {
+                REQUIRE(chess::magic::pext_bishop_moves(sq, bb) == magic_bishop);
+                REQUIRE(chess::magic::pext_rook_moves(sq, bb) == magic_rook);
+            }
+        }
+    }
+
+    if (!chess::magic::pext_supported()) {
+        REQUIRE(chess::magic::backend() == "magic");
+    }
+}
@@ -57,5 +57,15 @@ TEST_CASE("Position::num_repeats()") {
         }
 
         REQUIRE(pos.num_repeats() == repeats);
+        REQUIRE(pos.is_repetition() == (repeats > 1));
+
+        // The hash history survives undoing and replaying the last move
+        if (!movestrings.empty()) {
+            pos.undomove();
+            pos.makenull();
+            pos.undonull();
+            REQUIRE_NOTHROW(makemove(pos, movestrings.substr(movestrings.rfind(' ') + 1)));
+            REQUIRE(pos.num_repeats() == repeats);
+        }
     }
 }
@@ -0,0 +1,20 @@
+#include <doctest/doctest.h>
+#include <swizzles/bench.hpp>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - Bench signature") {
+    const auto results1 = swizzles::bench(4, 1);
+    const auto results2 = swizzles::bench(4, 1);
+
+    REQUIRE(results1.nodes > 0);
+    REQUIRE(results1.nodes == results2.nodes);
+    REQUIRE(results1.hash == 1);
+}
+
+TEST_CASE("Search - Bench limits") {
+    const auto results = swizzles::bench(1, 100'000);
+    REQUIRE(results.hash == 128);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,44 @@
+#include <doctest/doctest.h>
+#include <array>
+#include <chess/position.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <swizzles/search/root.hpp>
+#include <swizzles/uci/uci.hpp>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - Extension limits") {
+    // Positions full of checks and perpetual checks
+    const std::array<std::string, 4> fens = {{
+        "6k1/5p1p/6p1/8/8/8/q4PPP/3Q2K1 w - - 0 1",
+        "3q2k1/5ppp/8/8/8/8/5PPP/Q5K1 b - - 0 1",
+        "7k/6pp/8/8/8/8/1q4PP/3Q3K w - - 0 1",
+        "k7/p7/1p6/8/8/8/6Q1/K6q w - - 0 1",
+    }};
+
+    auto settings = swizzles::search::SearchSettings();
+    settings.type = swizzles::search::SearchType::Depth;
+    std::atomic<bool> stop = false;
+
+    for (const auto &fen : fens) {
+        for (const auto depth : {4, 6, 8}) {
+            INFO("FEN: ", fen);
+            INFO("Depth: ", depth);
+
+            auto state = swizzles::uci::UCIState();
+            state.tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+            state.pos.set_fen(fen);
+            settings.depth = depth;
+
+            const auto results = swizzles::search::root(state, settings, stop);
+
+            // Lines can only be extended for the first 2 * depth plies and by at most one ply per ply
+            REQUIRE(results.bestmove != chess::Move());
+            REQUIRE(results.seldepth <= 5 * depth);
+        }
+    }
+}
+
+TEST_SUITE_END();
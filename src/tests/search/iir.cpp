@@ -0,0 +1,57 @@
+#include <doctest/doctest.h>
+#include <array>
+#include <chess/position.hpp>
+#include <memory>
+#include <string>
+#include <swizzles/search/search.hpp>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - Internal iterative reduction") {
+    using swizzles::search::mate_score;
+
+    // Quiet positions, so the depth searched is only changed by the reduction
+    const std::array<std::string, 3> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    }};
+    constexpr int depth = 4;
+
+    auto settings = swizzles::search::SearchSettings();
+    std::atomic<bool> stop = false;
+    auto controller = swizzles::search::SearchController(settings, stop);
+
+    // The depth the root is stored with, after searching it with or without a move in the TT
+    const auto stored_depth = [&](const std::string &fen, const bool with_ttmove) {
+        auto pos = chess::Position(fen);
+        auto tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+
+        if (with_ttmove) {
+            // Too shallow to cut the search off, but still provides a move to search first
+            auto ttentry = swizzles::TTEntry();
+            ttentry.hash = pos.hash();
+            ttentry.move = *pos.movegen().begin();
+            ttentry.depth = 1;
+            ttentry.flag = swizzles::TTFlag::Upper;
+            tt->add(pos.hash(), ttentry);
+        }
+
+        auto td = std::make_unique<swizzles::search::ThreadData>(0, &controller, pos, tt);
+        td->root_depth = depth;
+        [[maybe_unused]] const auto score =
+            swizzles::search::search(*td, &td->stack[0], pos, -mate_score, mate_score, depth);
+
+        const auto ttentry = tt->poll(pos.hash());
+        REQUIRE(ttentry.hash == pos.hash());
+        return ttentry.depth;
+    };
+
+    for (const auto &fen : fens) {
+        INFO("FEN: ", fen);
+        REQUIRE(stored_depth(fen, false) == depth - 1);
+        REQUIRE(stored_depth(fen, true) == depth);
+    }
+}
+
+TEST_SUITE_END();
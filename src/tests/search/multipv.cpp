@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+#include <array>
+#include <chess/position.hpp>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <swizzles/search/root.hpp>
+#include <tuple>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - MultiPV") {
+    using tuple_type = std::tuple<std::string, int, std::size_t>;
+
+    // FEN, MultiPV, expected number of lines
+    const std::array<tuple_type, 5> tests = {{
+        {"startpos", 1, 1},
+        {"startpos", 4, 4},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 3},
+        {"7k/8/8/8/8/8/8/R6K b - - 0 1", 4, 3},
+        {"4k3/8/8/8/8/8/8/4K2R w K - 0 1", 64, 15},
+    }};
+
+    for (const auto &[fen, multipv, num_lines] : tests) {
+        INFO("FEN: ", fen);
+        INFO("MultiPV: ", multipv);
+
+        auto state = swizzles::uci::UCIState();
+        state.tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+        state.pos.set_fen(fen);
+        state.multipv.val = multipv;
+
+        // Remember the exact lines of the last iteration
+        std::map<int, std::pair<int, chess::Move>> lines;
+        int last_depth = 0;
+
+        auto settings = swizzles::search::SearchSettings();
+        settings.type = swizzles::search::SearchType::Depth;
+        settings.depth = 4;
+        settings.info_printer = [&](const int depth,
+                                    const int,
+                                    const int line,
+                                    const int eval,
+                                    const swizzles::search::Bound bound,
+                                    const std::uint64_t,
+                                    const std::uint64_t,
+                                    const std::uint64_t,
+                                    const int,
+                                    const int,
+                                    const swizzles::search::PV &pv) {
+            if (bound != swizzles::search::Bound::Exact) {
+                return;
+            }
+            if (depth != last_depth) {
+                lines.clear();
+                last_depth = depth;
+            }
+            REQUIRE(!pv.empty());
+            lines[line] = {eval, pv[0]};
+        };
+        std::atomic<bool> stop = false;
+
+        const auto results = swizzles::search::root(state, settings, stop);
+
+        REQUIRE(last_depth == settings.depth);
+        REQUIRE(lines.size() == num_lines);
+        REQUIRE(lines.begin()->first == 1);
+        REQUIRE(lines.begin()->second.second == results.bestmove);
+        REQUIRE(lines.begin()->second.first == results.eval);
+
+        std::set<std::string> moves;
+        int previous_eval = lines.begin()->second.first;
+        for (const auto &[line, info] : lines) {
+            moves.insert(static_cast<std::string>(info.second));
+            REQUIRE(info.first <= previous_eval);
+            previous_eval = info.first;
+        }
+        REQUIRE(moves.size() == num_lines);
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,49 @@
+#include <doctest/doctest.h>
+#include <array>
+#include <chess/position.hpp>
+#include <cstdint>
+#include <string>
+#include <swizzles/search/controller.hpp>
+#include <swizzles/search/root.hpp>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - Nodes") {
+    const std::array<std::string, 3> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    }};
+    constexpr std::array<std::uint64_t, 3> limits = {1'000, 10'000, 50'000};
+
+    // Search settings
+    auto settings = swizzles::search::SearchSettings();
+    settings.type = swizzles::search::SearchType::Nodes;
+    std::atomic<bool> stop = false;
+
+    for (const auto &fen : fens) {
+        for (const auto limit : limits) {
+            INFO("FEN: ", fen);
+            INFO("Nodes: ", limit);
+            settings.nodes = limit;
+
+            auto state = swizzles::uci::UCIState();
+            state.pos.set_fen(fen);
+
+            state.tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+            const auto results1 = swizzles::search::root(state, settings, stop);
+
+            state.tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+            const auto results2 = swizzles::search::root(state, settings, stop);
+
+            REQUIRE(results1.bestmove != chess::Move());
+            REQUIRE(results1.nodes <= limit + swizzles::search::SearchController::poll_frequency);
+            REQUIRE(results1.bestmove == results2.bestmove);
+            REQUIRE(results1.nodes == results2.nodes);
+            REQUIRE(results1.depth == results2.depth);
+            REQUIRE(results1.eval == results2.eval);
+        }
+    }
+}
+
+TEST_SUITE_END();
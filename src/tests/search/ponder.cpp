@@ -0,0 +1,47 @@
+#include <doctest/doctest.h>
+#include <atomic>
+#include <chess/position.hpp>
+#include <chrono>
+#include <future>
+#include <swizzles/search/root.hpp>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - Ponder") {
+    auto state = swizzles::uci::UCIState();
+    state.tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+
+    // Search settings
+    auto settings = swizzles::search::SearchSettings();
+    settings.type = swizzles::search::SearchType::Movetime;
+    settings.movetime = 50;
+    std::atomic<bool> stop = false;
+    std::atomic<bool> ponder = true;
+
+    auto future = std::async(std::launch::async, [&]() {
+        return swizzles::search::root(state, settings, stop, ponder);
+    });
+
+    SUBCASE("Ponderhit") {
+        // The movetime doesn't apply while pondering
+        REQUIRE(future.wait_for(std::chrono::milliseconds(200)) == std::future_status::timeout);
+
+        // The movetime starts from the ponderhit
+        const auto t0 = std::chrono::steady_clock::now();
+        ponder = false;
+        const auto results = future.get();
+        const auto t1 = std::chrono::steady_clock::now();
+        const auto dt = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+        REQUIRE(dt.count() <= settings.movetime + 50);
+        REQUIRE(results.bestmove != chess::Move());
+    }
+
+    SUBCASE("Stop") {
+        REQUIRE(future.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout);
+        stop = true;
+        const auto results = future.get();
+        REQUIRE(results.bestmove != chess::Move());
+    }
+}
+
+TEST_SUITE_END();
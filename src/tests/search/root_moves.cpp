@@ -0,0 +1,89 @@
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <array>
+#include <chess/position.hpp>
+#include <cstdint>
+#include <string>
+#include <swizzles/search/controller.hpp>
+#include <swizzles/search/search.hpp>
+#include <vector>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - Root moves") {
+    const std::array<std::string, 3> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    }};
+
+    for (const auto &fen : fens) {
+        INFO("FEN: ", fen);
+
+        std::vector<int> currmoves;
+        auto settings = swizzles::search::SearchSettings();
+        settings.type = swizzles::search::SearchType::Infinite;
+        settings.currmove_printer = [&](const int, const chess::Move, const int currmovenumber, const std::uint64_t) {
+            currmoves.push_back(currmovenumber);
+        };
+        std::atomic<bool> stop = false;
+        auto controller = swizzles::search::SearchController(settings, stop);
+        controller.start();
+
+        auto pos = chess::Position(fen);
+        auto td = swizzles::search::ThreadData(0, &controller, pos, std::make_shared<TT<swizzles::TTEntry>>(1));
+        for (const auto &move : pos.movegen()) {
+            pos.makemove(move);
+            if (!pos.is_attacked(pos.get_king(!pos.turn()), pos.turn())) {
+                td.root_moves.emplace_back(move);
+            }
+            pos.undomove();
+        }
+
+        for (int depth = 1; depth <= 5; ++depth) {
+            INFO("Depth: ", depth);
+            controller.set_depth(depth);
+            currmoves.clear();
+            for (auto &rm : td.root_moves) {
+                rm.nodes = 0;
+            }
+
+            const auto nodes_before = td.nodes;
+            const auto eval = swizzles::search::search_root(
+                td, td.pos, -swizzles::search::inf_score, swizzles::search::inf_score, depth);
+
+            // Every node of the iteration belongs to exactly one root move
+            std::uint64_t root_nodes = 0;
+            for (const auto &rm : td.root_moves) {
+                REQUIRE(rm.nodes > 0);
+                root_nodes += rm.nodes;
+            }
+            REQUIRE(root_nodes == td.nodes - nodes_before);
+
+            // An open window searches every root move in order
+            REQUIRE(currmoves.size() == td.root_moves.size());
+            for (std::size_t i = 0; i < currmoves.size(); ++i) {
+                REQUIRE(currmoves[i] == static_cast<int>(i) + 1);
+            }
+
+            const auto &pv = td.stack[0].pv;
+            REQUIRE(!pv.empty());
+            REQUIRE(std::any_of(td.root_moves.begin(), td.root_moves.end(), [&pv](const auto &rm) {
+                return rm.move == pv[0];
+            }));
+            REQUIRE(std::abs(eval) < swizzles::search::inf_score);
+        }
+
+        // Lower MultiPV lines skip the moves claimed by earlier lines, but keep their numbering
+        td.pv_idx = 2;
+        currmoves.clear();
+        [[maybe_unused]] const auto eval = swizzles::search::search_root(
+            td, td.pos, -swizzles::search::inf_score, swizzles::search::inf_score, 3);
+        REQUIRE(currmoves.size() == td.root_moves.size() - td.pv_idx);
+        for (std::size_t i = 0; i < currmoves.size(); ++i) {
+            REQUIRE(currmoves[i] == static_cast<int>(td.pv_idx + i) + 1);
+        }
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,76 @@
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <array>
+#include <chess/position.hpp>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <swizzles/search/root.hpp>
+#include <swizzles/uci/uci.hpp>
+#include <tuple>
+#include <vector>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - Searchmoves") {
+    using tuple_type = std::tuple<std::string, std::vector<std::string>, int>;
+
+    // FEN, searchmoves, MultiPV
+    const std::array<tuple_type, 4> tests = {{
+        {"startpos", {"a2a3"}, 1},
+        {"startpos", {"a2a3", "h2h3", "b1a3"}, 4},
+        {"6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - 0 1", {"h2h3", "g1f1"}, 1},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", {"e1g1", "a2a3"}, 2},
+    }};
+
+    for (const auto &[fen, movestrs, multipv] : tests) {
+        INFO("FEN: ", fen);
+        INFO("MultiPV: ", multipv);
+
+        auto state = swizzles::uci::UCIState();
+        state.tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+        state.pos.set_fen(fen);
+        state.multipv.val = multipv;
+
+        auto settings = swizzles::search::SearchSettings();
+        settings.type = swizzles::search::SearchType::Depth;
+        settings.depth = 4;
+        for (const auto &movestr : movestrs) {
+            const auto move = swizzles::uci::parse_move(state.pos, movestr);
+            REQUIRE(move != chess::Move());
+            settings.searchmoves.push_back(move);
+        }
+
+        // Every line reported must start with one of the searchmoves
+        std::set<std::string> seen;
+        settings.info_printer = [&](const int,
+                                    const int,
+                                    const int,
+                                    const int,
+                                    const swizzles::search::Bound,
+                                    const std::uint64_t,
+                                    const std::uint64_t,
+                                    const std::uint64_t,
+                                    const int,
+                                    const int,
+                                    const swizzles::search::PV &pv) {
+            REQUIRE(!pv.empty());
+            seen.insert(static_cast<std::string>(pv[0]));
+        };
+        std::atomic<bool> stop = false;
+
+        const auto results = swizzles::search::root(state, settings, stop);
+
+        const auto is_searchmove = [&](const chess::Move move) {
+            return std::find(settings.searchmoves.begin(), settings.searchmoves.end(), move) !=
+                   settings.searchmoves.end();
+        };
+        REQUIRE(is_searchmove(results.bestmove));
+        for (const auto &movestr : seen) {
+            REQUIRE(is_searchmove(swizzles::uci::parse_move(state.pos, movestr)));
+        }
+        REQUIRE(seen.size() == std::min(settings.searchmoves.size(), static_cast<std::size_t>(multipv)));
+    }
+}
+
+TEST_SUITE_END();
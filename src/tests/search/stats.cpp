@@ -0,0 +1,42 @@
+#include <doctest/doctest.h>
+#include <chess/position.hpp>
+#include <cstdint>
+#include <swizzles/search/root.hpp>
+#include <swizzles/search/stats.hpp>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - Stats") {
+    using swizzles::search::Stat;
+
+    auto state = swizzles::uci::UCIState();
+    state.tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+    state.pos.set_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+    auto settings = swizzles::search::SearchSettings();
+    settings.type = swizzles::search::SearchType::Depth;
+    settings.depth = 6;
+    std::atomic<bool> stop = false;
+
+    const auto results = swizzles::search::root(state, settings, stop);
+    const auto &stats = results.stats;
+
+    if constexpr (swizzles::search::stats_enabled) {
+        REQUIRE(stats.get(Stat::SearchNodes) > 0);
+        REQUIRE(stats.get(Stat::QsearchNodes) > 0);
+        REQUIRE(stats.get(Stat::TTHits) <= stats.get(Stat::TTProbes));
+        REQUIRE(stats.get(Stat::TTCutoffs) <= stats.get(Stat::TTHits));
+        REQUIRE(stats.get(Stat::FirstMoveCutoffs) <= stats.get(Stat::BetaCutoffs));
+        REQUIRE(stats.get(Stat::NullMoveCutoffs) <= stats.get(Stat::NullMoveTries));
+        REQUIRE(stats.get(Stat::ProbcutCutoffs) <= stats.get(Stat::ProbcutTries));
+        REQUIRE(stats.get(Stat::LMRResearches) <= stats.get(Stat::LMRSearches));
+    } else {
+        // Disabled statistics take no space and always read zero
+        REQUIRE(sizeof(swizzles::search::Stats) == 1);
+        for (std::size_t i = 0; i < swizzles::search::num_stats; ++i) {
+            REQUIRE(stats.get(static_cast<Stat>(i)) == 0);
+        }
+    }
+}
+
+TEST_SUITE_END();
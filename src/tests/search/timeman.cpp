@@ -0,0 +1,125 @@
+#include <doctest/doctest.h>
+#include <array>
+#include <chess/move.hpp>
+#include <swizzles/search/timeman.hpp>
+#include <tuple>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Time management - Limits") {
+    using tuple_type = std::tuple<int, int, int>;
+
+    const std::array<tuple_type, 8> tests = {{
+        {60'000, 0, 0},
+        {60'000, 1'000, 0},
+        {10'000, 100, 0},
+        {1'000, 10, 0},
+        {100, 1'000, 0},
+        {300'000, 0, 40},
+        {5'000, 0, 1},
+        {10, 0, 0},
+    }};
+
+    for (const auto &[time, inc, movestogo] : tests) {
+        INFO("Time: ", time);
+        INFO("Inc: ", inc);
+        INFO("Movestogo: ", movestogo);
+        const auto limits = swizzles::search::allocate_time(time, inc, movestogo);
+        REQUIRE(limits.soft <= limits.hard);
+        REQUIRE(limits.hard < time);
+        REQUIRE(limits.soft >= 0);
+    }
+}
+
+TEST_CASE("Time management - Simulated games") {
+    using tuple_type = std::tuple<int, int, int>;
+
+    // Time, increment, moves per time control
+    const std::array<tuple_type, 7> controls = {{
+        {60'000, 0, 0},
+        {10'000, 100, 0},
+        {1'000, 10, 0},
+        {100, 100, 0},
+        {300'000, 0, 40},
+        {10'000, 0, 40},
+        {1'000, 0, 10},
+    }};
+
+    for (const auto &[start_time, inc, moves_per_control] : controls) {
+        INFO("Time: ", start_time);
+        INFO("Inc: ", inc);
+        INFO("Moves per control: ", moves_per_control);
+
+        auto clock = start_time;
+        auto movestogo = moves_per_control;
+
+        for (int ply = 0; ply < 200; ++ply) {
+            INFO("Move: ", ply + 1);
+            const auto limits = swizzles::search::allocate_time(clock, inc, movestogo);
+
+            // Worst case: every search is aborted at the hard limit
+            // - The move overhead must never be eaten into, it's reserved for GUI lag
+            clock -= limits.hard;
+            REQUIRE(clock >= swizzles::search::move_overhead);
+            clock += inc;
+
+            if (moves_per_control > 0) {
+                movestogo--;
+                if (movestogo == 0) {
+                    clock += start_time;
+                    movestogo = moves_per_control;
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Time management - Stability") {
+    const auto limits = swizzles::search::allocate_time(60'000, 1'000, 0);
+    const auto a = chess::Move(chess::MoveType::Double, chess::PieceType::Pawn, chess::Square::E2, chess::Square::E4);
+    const auto b = chess::Move(chess::MoveType::Double, chess::PieceType::Pawn, chess::Square::D2, chess::Square::D4);
+
+    SUBCASE("Stable best move uses less time") {
+        auto timeman = swizzles::search::TimeManager(limits);
+        timeman.update(a, 20, 50);
+        const auto before = timeman.soft_limit();
+        for (int i = 0; i < 8; ++i) {
+            timeman.update(a, 20, 50);
+        }
+        REQUIRE(timeman.soft_limit() < limits.soft);
+        REQUIRE(timeman.soft_limit() < before);
+    }
+
+    SUBCASE("Changing best move uses more time") {
+        auto timeman = swizzles::search::TimeManager(limits);
+        for (int i = 0; i < 8; ++i) {
+            timeman.update(i % 2 ? a : b, 20, 50);
+        }
+        REQUIRE(timeman.soft_limit() > limits.soft);
+        REQUIRE(timeman.soft_limit() <= limits.hard);
+    }
+
+    SUBCASE("Score drop uses more time") {
+        auto stable = swizzles::search::TimeManager(limits);
+        auto dropped = swizzles::search::TimeManager(limits);
+        for (int i = 0; i < 8; ++i) {
+            stable.update(a, 20, 50);
+            dropped.update(a, i < 7 ? 20 : -30, 50);
+        }
+        REQUIRE(dropped.soft_limit() > stable.soft_limit());
+        REQUIRE(dropped.soft_limit() <= limits.hard);
+    }
+
+    SUBCASE("Best move node share") {
+        auto dominant = swizzles::search::TimeManager(limits);
+        auto contested = swizzles::search::TimeManager(limits);
+        for (int i = 0; i < 8; ++i) {
+            dominant.update(a, 20, 90);
+            contested.update(a, 20, 20);
+        }
+        REQUIRE(dominant.soft_limit() < contested.soft_limit());
+        REQUIRE(contested.soft_limit() <= limits.hard);
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,73 @@
+#include <doctest/doctest.h>
+#include <array>
+#include <chess/position.hpp>
+#include <memory>
+#include <string>
+#include <swizzles/search/root.hpp>
+#include <swizzles/search/search.hpp>
+
+TEST_SUITE_BEGIN("Search");
+
+TEST_CASE("Search - TT entries") {
+    const std::array<std::string, 3> fens = {{
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    }};
+
+    // Search settings
+    auto settings = swizzles::search::SearchSettings();
+    settings.type = swizzles::search::SearchType::Depth;
+    settings.depth = 4;
+    std::atomic<bool> stop = false;
+
+    for (const auto &fen : fens) {
+        INFO("FEN: ", fen);
+
+        auto state = swizzles::uci::UCIState();
+        state.pos.set_fen(fen);
+        state.tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+
+        const auto results = swizzles::search::root(state, settings, stop);
+
+        // The root's entry has to be found again by its hash, or the TT can never be hit
+        const auto ttentry = state.tt->poll(state.pos.hash());
+        REQUIRE(ttentry.hash == state.pos.hash());
+        REQUIRE(ttentry.move == results.bestmove);
+        REQUIRE(ttentry.depth == settings.depth);
+    }
+}
+
+TEST_CASE("Search - TT bounds under a raised alpha") {
+    using swizzles::search::mate_score;
+
+    // An equal position, with a deeper lower bound far above what a shallow search finds
+    auto pos = chess::Position("startpos");
+    constexpr int depth = 2;
+    constexpr int bound = 500;
+
+    auto tt = std::make_shared<TT<swizzles::TTEntry>>(1);
+    auto ttentry = swizzles::TTEntry();
+    ttentry.hash = pos.hash();
+    ttentry.eval = bound;
+    ttentry.depth = depth + 1;
+    ttentry.flag = swizzles::TTFlag::Lower;
+    tt->add(pos.hash(), ttentry);
+
+    auto settings = swizzles::search::SearchSettings();
+    std::atomic<bool> stop = false;
+    auto controller = swizzles::search::SearchController(settings, stop);
+    auto td = std::make_unique<swizzles::search::ThreadData>(0, &controller, pos, tt);
+    td->root_depth = depth;
+
+    // The bound raises alpha from -mate_score, then every move fails low against it
+    const auto score = swizzles::search::search(*td, &td->stack[0], pos, -mate_score, mate_score, depth);
+    REQUIRE(score <= bound);
+
+    const auto stored = tt->poll(pos.hash());
+    REQUIRE(stored.hash == pos.hash());
+    REQUIRE(stored.depth == depth);
+    REQUIRE(stored.flag == swizzles::TTFlag::Upper);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,506 @@
+#ifndef TOOLS_BENCH_COMMON_HPP
+#define TOOLS_BENCH_COMMON_HPP
+
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+enum class Format : int
+{
+    Table = 0,
+    Json,
+    Csv,
+};
+
+struct Options {
+    int depth = 1;
+    int repeats = 1;
+    Format format = Format::Table;
+    std::string baseline;
+};
+
+// One position searched once
+struct Sample {
+    int run = 0;
+    int position = 0;
+    std::uint64_t nodes = 0;
+    double ms = 0.0;
+
+    [[nodiscard]] auto nps() const noexcept -> double {
+        return ms > 0.0 ? 1000.0 * static_cast<double>(nodes) / ms : 0.0;
+    }
+};
+
+struct HostInfo {
+    std::string hostname;
+    std::string cpu;
+    unsigned int cores = 0;
+    std::string compiler;
+    std::string flags;
+};
+
+// Whole string as a number
+template <typename T>
+[[nodiscard]] inline auto parse_number(const std::string &str) noexcept -> std::optional<T> {
+    T value = 0;
+    const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (ec != std::errc() || ptr != str.data() + str.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Whole string as a positive integer
+[[nodiscard]] inline auto parse_positive(const std::string &str) noexcept -> std::optional<int> {
+    const auto value = parse_number<int>(str);
+    if (!value || *value < 1) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// bench_x [depth] [--repeat n] [--format table|json|csv] [--baseline path]
+// Prints the usage and returns nothing if an argument isn't understood
+[[nodiscard]] inline auto parse_options(const int argc, const char **argv, const int default_depth)
+    -> std::optional<Options> {
+    auto opts = Options();
+    opts.depth = default_depth;
+
+    const auto usage = [&](const std::string &error) {
+        std::cerr << error << "\n";
+        std::cerr << "Usage: " << argv[0] << " [depth] [--repeat n] [--format table|json|csv] [--baseline path]"
+                  << std::endl;
+        return std::nullopt;
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        const auto arg = std::string(argv[i]);
+        const auto has_value = i + 1 < argc;
+
+        if (arg == "--repeat" && has_value) {
+            const auto value = parse_positive(argv[++i]);
+            if (!value) {
+                return usage("Invalid repeat count " + std::string(argv[i]));
+            }
+            opts.repeats = *value;
+        } else if (arg == "--format" && has_value) {
+            const auto value = std::string(argv[++i]);
+            if (value == "table") {
+                opts.format = Format::Table;
+            } else if (value == "json") {
+                opts.format = Format::Json;
+            } else if (value == "csv") {
+                opts.format = Format::Csv;
+            } else {
+                return usage("Unknown format " + value);
+            }
+        } else if (arg == "--baseline" && has_value) {
+            opts.baseline = argv[++i];
+        } else if (const auto depth = parse_positive(arg)) {
+            opts.depth = *depth;
+        } else {
+            return usage("Unknown option " + arg);
+        }
+    }
+
+    return opts;
+}
+
+[[nodiscard]] inline auto get_host_info() -> HostInfo {
+    auto info = HostInfo();
+
+    std::array<char, 256> hostname = {};
+    if (gethostname(hostname.data(), hostname.size() - 1) == 0) {
+        info.hostname = hostname.data();
+    }
+
+    auto cpuinfo = std::ifstream("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.starts_with("model name")) {
+            const auto colon = line.find(':');
+            if (colon != std::string::npos && colon + 2 <= line.size()) {
+                info.cpu = line.substr(colon + 2);
+            }
+            break;
+        }
+    }
+
+    info.cores = std::thread::hardware_concurrency();
+
+#if defined(__clang__)
+    info.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    info.compiler = "gcc " __VERSION__;
+#endif
+
+#ifdef NDEBUG
+    info.flags += "release";
+#else
+    info.flags += "debug";
+#endif
+#ifdef __POPCNT__
+    info.flags += " popcnt";
+#endif
+#ifdef __BMI2__
+    info.flags += " bmi2";
+#endif
+#ifdef __AVX2__
+    info.flags += " avx2";
+#endif
+#ifdef __AVX512F__
+    info.flags += " avx512f";
+#endif
+#ifdef SWIZZLES_STATS
+    info.flags += " stats";
+#endif
+
+    return info;
+}
+
+[[nodiscard]] inline auto json_escape(const std::string &str) -> std::string {
+    std::string out;
+    for (const auto c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+// Each sample is written on its own line so read_samples() can parse the file back without a JSON library
+inline auto write_json(std::ostream &os,
+                       const std::string &tool,
+                       const Options &opts,
+                       const HostInfo &host,
+                       const std::vector<Sample> &samples) -> void {
+    os << "{\n";
+    os << "  \"tool\": \"" << json_escape(tool) << "\",\n";
+    os << "  \"depth\": " << opts.depth << ",\n";
+    os << "  \"repeats\": " << opts.repeats << ",\n";
+    os << "  \"host\": {\n";
+    os << "    \"hostname\": \"" << json_escape(host.hostname) << "\",\n";
+    os << "    \"cpu\": \"" << json_escape(host.cpu) << "\",\n";
+    os << "    \"cores\": " << host.cores << ",\n";
+    os << "    \"compiler\": \"" << json_escape(host.compiler) << "\",\n";
+    os << "    \"flags\": \"" << json_escape(host.flags) << "\"\n";
+    os << "  },\n";
+    os << "  \"samples\": [\n";
+    os << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const auto &s = samples[i];
+        os << "    {\"run\": " << s.run << ", \"position\": " << s.position << ", \"nodes\": " << s.nodes
+           << ", \"time_ms\": " << s.ms << ", \"nps\": " << std::setprecision(0) << s.nps() << std::setprecision(3)
+           << "}" << (i + 1 < samples.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n";
+    os << "}" << std::endl;
+}
+
+// The host info is repeated on every row so each line stands alone in a dashboard
+inline auto write_csv(std::ostream &os,
+                      const std::string &tool,
+                      const Options &opts,
+                      const HostInfo &host,
+                      const std::vector<Sample> &samples) -> void {
+    os << "tool,depth,hostname,cpu,cores,compiler,flags,run,position,nodes,time_ms,nps\n";
+    os << std::fixed;
+    for (const auto &s : samples) {
+        os << tool << "," << opts.depth << "," << host.hostname << ",\"" << host.cpu << "\"," << host.cores << ",\""
+           << host.compiler << "\",\"" << host.flags << "\"," << s.run << "," << s.position << "," << s.nodes << ","
+           << std::setprecision(3) << s.ms << "," << std::setprecision(0) << s.nps() << "\n";
+    }
+    os << std::flush;
+}
+
+// Split a CSV line, quoted fields may contain commas
+[[nodiscard]] inline auto split_csv(const std::string &line) -> std::vector<std::string> {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (const auto c : line) {
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (c == ',' && !quoted) {
+            fields.emplace_back();
+        } else {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+// Find "key": value on a line written by write_json()
+[[nodiscard]] inline auto json_number(const std::string &line, const std::string &key) -> std::string {
+    const auto needle = "\"" + key + "\": ";
+    const auto start = line.find(needle);
+    if (start == std::string::npos) {
+        return {};
+    }
+    const auto begin = start + needle.size();
+    const auto end = line.find_first_of(",}", begin);
+    return line.substr(begin, end - begin);
+}
+
+// Read the samples from a file written with --format json or --format csv
+// Returns nothing if a sample can't be parsed
+[[nodiscard]] inline auto read_samples(const std::string &path) -> std::optional<std::vector<Sample>> {
+    std::vector<Sample> samples;
+    auto file = std::ifstream(path);
+    std::string line;
+    std::size_t line_number = 0;
+    std::map<std::string, std::size_t> columns;
+
+    const auto sample = [](const std::string &run,
+                           const std::string &position,
+                           const std::string &nodes,
+                           const std::string &ms) -> std::optional<Sample> {
+        auto s = Sample();
+        const auto r = parse_number<int>(run);
+        const auto p = parse_number<int>(position);
+        const auto n = parse_number<std::uint64_t>(nodes);
+        const auto t = parse_number<double>(ms);
+        if (!r || !p || !n || !t) {
+            return std::nullopt;
+        }
+        s.run = *r;
+        s.position = *p;
+        s.nodes = *n;
+        s.ms = *t;
+        return s;
+    };
+
+    while (std::getline(file, line)) {
+        line_number++;
+        auto s = std::optional<Sample>();
+
+        if (line.find("\"position\": ") != std::string::npos) {
+            s = sample(json_number(line, "run"),
+                       json_number(line, "position"),
+                       json_number(line, "nodes"),
+                       json_number(line, "time_ms"));
+        } else if (line.starts_with("tool,")) {
+            const auto header = split_csv(line);
+            for (std::size_t i = 0; i < header.size(); ++i) {
+                columns[header[i]] = i;
+            }
+            continue;
+        } else if (!columns.empty()) {
+            const auto fields = split_csv(line);
+            if (fields.size() != columns.size()) {
+                continue;
+            }
+            s = sample(fields.at(columns["run"]),
+                       fields.at(columns["position"]),
+                       fields.at(columns["nodes"]),
+                       fields.at(columns["time_ms"]));
+        } else {
+            continue;
+        }
+
+        if (!s) {
+            std::cerr << "malformed baseline line " << line_number << std::endl;
+            return std::nullopt;
+        }
+        samples.push_back(*s);
+    }
+
+    return samples;
+}
+
+struct Welch {
+    double t = 0.0;
+    double df = 0.0;
+};
+
+// Welch's t-test between two sets of measurements with unequal variances
+[[nodiscard]] inline auto welch(const std::vector<double> &a, const std::vector<double> &b) noexcept -> Welch {
+    const auto mean = [](const std::vector<double> &v) {
+        double sum = 0.0;
+        for (const auto x : v) {
+            sum += x;
+        }
+        return sum / static_cast<double>(v.size());
+    };
+
+    const auto variance = [](const std::vector<double> &v, const double m) {
+        double sum = 0.0;
+        for (const auto x : v) {
+            sum += (x - m) * (x - m);
+        }
+        return sum / static_cast<double>(v.size() - 1);
+    };
+
+    const auto ma = mean(a);
+    const auto mb = mean(b);
+    const auto va = variance(a, ma) / static_cast<double>(a.size());
+    const auto vb = variance(b, mb) / static_cast<double>(b.size());
+    const auto se = std::sqrt(va + vb);
+
+    if (se == 0.0) {
+        return {ma == mb ? 0.0 : (ma < mb ? -1e9 : 1e9), static_cast<double>(a.size() + b.size() - 2)};
+    }
+
+    const auto df = (va + vb) * (va + vb) /
+                    (va * va / static_cast<double>(a.size() - 1) + vb * vb / static_cast<double>(b.size() - 1));
+    return {(ma - mb) / se, df};
+}
+
+// Two tailed critical value of Student's t at 95% confidence
+[[nodiscard]] inline auto critical_t(const double df) noexcept -> double {
+    constexpr std::array<double, 30> table = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+        2.120,  2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    const auto idx = static_cast<std::size_t>(std::floor(df));
+    if (idx < 1) {
+        return table.front();
+    } else if (idx <= table.size()) {
+        return table[idx - 1];
+    }
+    return 1.960;
+}
+
+// Compare the nps of every position, and of each whole run, against the baseline
+// Returns true if anything got significantly slower
+inline auto compare(std::ostream &os, const std::vector<Sample> &baseline, const std::vector<Sample> &current)
+    -> bool {
+    // Position 0 holds the nps of each whole run
+    const auto group = [](const std::vector<Sample> &samples) {
+        std::map<int, std::vector<double>> nps;
+        std::map<int, Sample> totals;
+        for (const auto &s : samples) {
+            nps[s.position].push_back(s.nps());
+            totals[s.run].nodes += s.nodes;
+            totals[s.run].ms += s.ms;
+        }
+        for (const auto &[run, total] : totals) {
+            nps[0].push_back(total.nps());
+        }
+        return nps;
+    };
+
+    // A different node count means a different workload, so the nps can't be compared
+    // Position 0 holds the nodes of a whole run
+    const auto nodes = [](const std::vector<Sample> &samples) {
+        std::map<int, std::uint64_t> counts;
+        for (const auto &s : samples) {
+            counts[s.position] = s.nodes;
+        }
+        std::uint64_t total = 0;
+        for (const auto &[position, count] : counts) {
+            total += count;
+        }
+        counts[0] = total;
+        return counts;
+    };
+
+    const auto base = group(baseline);
+    const auto curr = group(current);
+    const auto base_nodes = nodes(baseline);
+    const auto curr_nodes = nodes(current);
+    bool slower = false;
+
+    os << std::left;
+    os << std::setw(7) << "Pos";
+    os << std::right;
+    os << std::setw(14) << "Base nps";
+    os << std::setw(14) << "Curr nps";
+    os << std::setw(9) << "Change";
+    os << std::setw(9) << "t";
+    os << "  Result";
+    os << "\n";
+
+    for (const auto &[position, curr_nps] : curr) {
+        const auto iter = base.find(position);
+        if (iter == base.end()) {
+            continue;
+        }
+
+        const auto &base_nps = iter->second;
+        double base_mean = 0.0;
+        double curr_mean = 0.0;
+        for (const auto x : base_nps) {
+            base_mean += x / static_cast<double>(base_nps.size());
+        }
+        for (const auto x : curr_nps) {
+            curr_mean += x / static_cast<double>(curr_nps.size());
+        }
+
+        std::string result = "n/a";
+        double t = 0.0;
+        if (base_nodes.at(position) != curr_nodes.at(position)) {
+            result = "nodes differ";
+        } else if (base_nps.size() >= 2 && curr_nps.size() >= 2) {
+            const auto test = welch(curr_nps, base_nps);
+            t = test.t;
+            if (std::abs(t) <= critical_t(test.df)) {
+                result = "same";
+            } else if (t < 0.0) {
+                result = "SLOWER";
+                slower = true;
+            } else {
+                result = "faster";
+            }
+        }
+
+        os << std::left;
+        os << std::setw(7) << (position == 0 ? std::string("Total") : std::to_string(position));
+        os << std::right << std::fixed << std::setprecision(0);
+        os << std::setw(14) << base_mean;
+        os << std::setw(14) << curr_mean;
+        os << std::setprecision(1);
+        os << std::setw(8) << (base_mean > 0.0 ? 100.0 * (curr_mean - base_mean) / base_mean : 0.0) << "%";
+        os << std::setprecision(2);
+        os << std::setw(9) << std::clamp(t, -999.99, 999.99);
+        os << "  " << result;
+        os << "\n";
+    }
+
+    os << std::flush;
+    return slower;
+}
+
+// Print the machine readable results and run the baseline comparison if one was given
+// Returns the process exit code, 1 for a significant slowdown
+inline auto report(const std::string &tool, const Options &opts, const std::vector<Sample> &samples) -> int {
+    if (opts.format == Format::Json) {
+        write_json(std::cout, tool, opts, get_host_info(), samples);
+    } else if (opts.format == Format::Csv) {
+        write_csv(std::cout, tool, opts, get_host_info(), samples);
+    }
+
+    if (opts.baseline.empty()) {
+        return 0;
+    }
+
+    const auto baseline = read_samples(opts.baseline);
+    if (!baseline) {
+        return 2;
+    } else if (baseline->empty()) {
+        std::cerr << "No samples in baseline " << opts.baseline << std::endl;
+        return 2;
+    }
+
+    // Keep stdout machine readable
+    auto &os = opts.format == Format::Table ? std::cout : std::cerr;
+    os << "\nBaseline: " << opts.baseline << "\n";
+    return compare(os, *baseline, samples) ? 1 : 0;
+}
+
+}  // namespace bench
+
+#endif
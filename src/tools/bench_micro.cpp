@@ -0,0 +1,365 @@
+#include <array>
+#include <chess/fill.hpp>
+#include <chess/magic.hpp>
+#include <chess/movelist.hpp>
+#include <chess/position.hpp>
+#include <chess/see.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <perf_counters.hpp>
+#include <string>
+#include <swizzles/bench.hpp>
+#include <swizzles/eval/eval.hpp>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "bench_common.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_MICRO_RDTSC
+#endif
+
+// Time stamp counter ticks, these match core cycles only with a fixed clock speed
+[[nodiscard]] auto read_cycles() noexcept -> std::uint64_t {
+#ifdef BENCH_MICRO_RDTSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+#if defined(__AVX512F__)
+constexpr auto fill_kernel = "avx512";
+#elif defined(__AVX2__)
+constexpr auto fill_kernel = "avx2";
+#else
+constexpr auto fill_kernel = "scalar";
+#endif
+
+// Deterministic so every run benchmarks the same positions
+class XorShift {
+   public:
+    [[nodiscard]] auto next() noexcept -> std::uint64_t {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 7;
+        m_state ^= m_state << 17;
+        return m_state;
+    }
+
+   private:
+    std::uint64_t m_state = 0x9E3779B97F4A7C15ULL;
+};
+
+[[nodiscard]] auto legal_moves(chess::Position &pos) noexcept -> std::vector<chess::Move> {
+    std::vector<chess::Move> legal;
+    for (const auto &move : pos.movegen()) {
+        pos.makemove<false>(move);
+        if (!pos.is_attacked(pos.get_king(!pos.turn()), pos.turn())) {
+            legal.push_back(move);
+        }
+        pos.undomove();
+    }
+    return legal;
+}
+
+// Random playouts from the bench positions, keeping every position reached along the way
+[[nodiscard]] auto generate_positions(const std::size_t count) noexcept -> std::vector<chess::Position> {
+    constexpr int max_plies = 80;
+    auto rng = XorShift();
+    std::vector<chess::Position> positions;
+    positions.reserve(count);
+
+    while (positions.size() < count) {
+        for (const auto &fen : swizzles::bench_fens) {
+            auto pos = chess::Position(fen);
+
+            for (int ply = 0; ply < max_plies && positions.size() < count; ++ply) {
+                const auto moves = legal_moves(pos);
+                if (moves.empty() || pos.halfmoves() >= 100) {
+                    break;
+                }
+                pos.makemove(moves.at(rng.next() % moves.size()));
+                positions.push_back(pos);
+            }
+        }
+    }
+
+    return positions;
+}
+
+struct Timing {
+    std::uint64_t ops = 0;
+    std::chrono::nanoseconds time = std::chrono::nanoseconds(0);
+    std::uint64_t cycles = 0;
+    perf::Counts counts;
+};
+
+// func runs the primitive over the whole position set once and returns the number of operations performed
+[[nodiscard]] auto measure(const perf::PerfCounters &counters,
+                           const int repeats,
+                           const std::function<std::uint64_t()> &func) noexcept -> Timing {
+    auto timing = Timing();
+
+    // Warm up the caches and branch predictors
+    static_cast<void>(func());
+
+    for (int i = 0; i < repeats; ++i) {
+        const auto p0 = counters.read();
+        const auto t0 = std::chrono::steady_clock::now();
+        const auto c0 = read_cycles();
+        timing.ops += func();
+        const auto c1 = read_cycles();
+        const auto t1 = std::chrono::steady_clock::now();
+        timing.counts += counters.read() - p0;
+
+        timing.time += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+        timing.cycles += c1 - c0;
+    }
+
+    return timing;
+}
+
+int main(const int argc, const char **argv) {
+    std::size_t num_positions = 10'000;
+    int repeats = 10;
+
+    const auto usage = [&](const std::string &error) {
+        std::cerr << error << "\n";
+        std::cerr << "Usage: " << argv[0] << " [positions] [repeats]" << std::endl;
+        return 2;
+    };
+
+    if (argc > 3) {
+        return usage("Unknown option " + std::string(argv[3]));
+    }
+    if (argc > 1) {
+        const auto value = bench::parse_positive(argv[1]);
+        if (!value) {
+            return usage("Invalid position count " + std::string(argv[1]));
+        }
+        num_positions = static_cast<std::size_t>(*value);
+    }
+    if (argc > 2) {
+        const auto value = bench::parse_positive(argv[2]);
+        if (!value) {
+            return usage("Invalid repeat count " + std::string(argv[2]));
+        }
+        repeats = *value;
+    }
+
+    auto positions = generate_positions(num_positions);
+
+    // Move lists are generated up front so only the primitive itself is timed
+    std::vector<chess::MoveList> all_moves;
+    std::vector<chess::MoveList> all_captures;
+    for (const auto &pos : positions) {
+        all_moves.push_back(pos.movegen());
+        all_captures.push_back(pos.captures());
+    }
+
+    const std::array<int, 7> see_values = {100, 300, 300, 500, 900, 1'000'000, 0};
+
+    // Results are summed into the sink so the work can't be optimised away
+    std::uint64_t sink = 0;
+
+    std::vector<std::pair<std::string, std::function<std::uint64_t()>>> benches;
+
+    // Time each slider backend this CPU supports, whichever one the other primitives use
+    using Lookup = chess::Bitboard (*)(const chess::Square, const chess::Bitboard) noexcept;
+    std::vector<std::tuple<std::string, Lookup, Lookup>> backends = {
+        {"magic", chess::magic::magic_rook_moves, chess::magic::magic_bishop_moves}};
+    if (chess::magic::pext_supported()) {
+        backends.emplace_back("pext", chess::magic::pext_rook_moves, chess::magic::pext_bishop_moves);
+    }
+
+    for (const auto &[backend_name, rook_moves, bishop_moves] : backends) {
+        benches.emplace_back("rook_moves " + backend_name, [&, rook_moves] {
+            for (const auto &pos : positions) {
+                const auto occ = pos.get_occupied();
+                for (int sq = 0; sq < 64; ++sq) {
+                    sink += rook_moves(chess::Square(sq), occ).count();
+                }
+            }
+            return 64 * positions.size();
+        });
+        benches.emplace_back("bishop_moves " + backend_name, [&, bishop_moves] {
+            for (const auto &pos : positions) {
+                const auto occ = pos.get_occupied();
+                for (int sq = 0; sq < 64; ++sq) {
+                    sink += bishop_moves(chess::Square(sq), occ).count();
+                }
+            }
+            return 64 * positions.size();
+        });
+    }
+
+    const std::vector<std::pair<std::string, std::function<std::uint64_t()>>> primitives = {
+        {"movegen",
+         [&] {
+             for (const auto &pos : positions) {
+                 sink += pos.movegen().size();
+             }
+             return positions.size();
+         }},
+        {"captures",
+         [&] {
+             for (const auto &pos : positions) {
+                 sink += pos.captures().size();
+             }
+             return positions.size();
+         }},
+        {"quiets",
+         [&] {
+             for (const auto &pos : positions) {
+                 sink += pos.quiets().size();
+             }
+             return positions.size();
+         }},
+        {"makemove+undomove",
+         [&] {
+             std::uint64_t ops = 0;
+             for (std::size_t i = 0; i < positions.size(); ++i) {
+                 auto &pos = positions[i];
+                 for (const auto &move : all_moves[i]) {
+                     pos.makemove(move);
+                     sink += pos.hash();
+                     pos.undomove();
+                 }
+                 ops += all_moves[i].size();
+             }
+             return ops;
+         }},
+        {"slider lookups",
+         [&] {
+             for (const auto &pos : positions) {
+                 const auto us = pos.turn();
+                 const auto occ = pos.get_occupied();
+                 auto attacks = chess::Bitboard();
+                 for (const auto sq : pos.get_rooks(us) | pos.get_queens(us)) {
+                     attacks |= chess::magic::rook_moves(sq, occ);
+                 }
+                 for (const auto sq : pos.get_bishops(us) | pos.get_queens(us)) {
+                     attacks |= chess::magic::bishop_moves(sq, occ);
+                 }
+                 sink += attacks.data();
+             }
+             return positions.size();
+         }},
+        {"slider fill scalar",
+         [&] {
+             for (const auto &pos : positions) {
+                 const auto us = pos.turn();
+                 const auto empty = ~pos.get_occupied();
+                 const auto attacks =
+                     chess::fill::rook_scalar(pos.get_rooks(us) | pos.get_queens(us), empty) |
+                     chess::fill::bishop_scalar(pos.get_bishops(us) | pos.get_queens(us), empty);
+                 sink += attacks.data();
+             }
+             return positions.size();
+         }},
+        {"slider fill " + std::string(fill_kernel),
+         [&] {
+             for (const auto &pos : positions) {
+                 const auto us = pos.turn();
+                 const auto attacks = chess::fill::slider_attacks(
+                     pos.get_rooks(us) | pos.get_queens(us), pos.get_bishops(us) | pos.get_queens(us), ~pos.get_occupied());
+                 sink += attacks.data();
+             }
+             return positions.size();
+         }},
+        {"is_attacked squares",
+         [&] {
+             for (const auto &pos : positions) {
+                 const auto ksq = pos.get_king(pos.turn());
+                 const auto escapes = chess::Bitboard(ksq).adjacent() & ~pos.get_occupied();
+                 sink += pos.is_attacked(escapes, !pos.turn());
+             }
+             return positions.size();
+         }},
+        {"is_attacked",
+         [&] {
+             for (const auto &pos : positions) {
+                 sink += pos.is_attacked(pos.get_king(pos.turn()), !pos.turn());
+             }
+             return positions.size();
+         }},
+        {"see",
+         [&] {
+             std::uint64_t ops = 0;
+             for (std::size_t i = 0; i < positions.size(); ++i) {
+                 for (const auto &move : all_captures[i]) {
+                     sink += chess::see_move(positions[i], move, see_values);
+                 }
+                 ops += all_captures[i].size();
+             }
+             return ops;
+         }},
+        {"calculate_hash",
+         [&] {
+             for (const auto &pos : positions) {
+                 sink += pos.calculate_hash();
+             }
+             return positions.size();
+         }},
+        {"eval",
+         [&] {
+             for (const auto &pos : positions) {
+                 sink += swizzles::eval::eval(pos);
+             }
+             return positions.size();
+         }},
+    };
+    benches.insert(benches.end(), primitives.begin(), primitives.end());
+
+    const auto counters = perf::PerfCounters();
+
+    std::cout << "Positions: " << positions.size() << "\n";
+    std::cout << "Repeats: " << repeats << "\n";
+    std::cout << "Sliders: " << chess::magic::backend() << "\n";
+    if (!counters.any_available()) {
+        std::cout << "Hardware counters unavailable\n";
+    }
+
+    // Print chart title
+    std::cout << std::left;
+    std::cout << std::setw(20) << "Primitive";
+    std::cout << std::right;
+    std::cout << std::setw(12) << "Ops";
+    std::cout << std::setw(10) << "ns/op";
+    std::cout << std::setw(12) << "cycles/op";
+    if (counters.any_available()) {
+        std::cout << "  Counters (misses per 1000 instructions)";
+    }
+    std::cout << "\n";
+
+    for (const auto &[name, func] : benches) {
+        const auto timing = measure(counters, repeats, func);
+        const auto ops = static_cast<double>(timing.ops);
+
+        // Print chart row
+        std::cout << std::left;
+        std::cout << std::setw(20) << name;
+        std::cout << std::right;
+        std::cout << std::setw(12) << timing.ops;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << std::setw(10) << static_cast<double>(timing.time.count()) / ops;
+#ifdef BENCH_MICRO_RDTSC
+        std::cout << std::setw(12) << static_cast<double>(timing.cycles) / ops;
+#else
+        std::cout << std::setw(12) << "-";
+#endif
+        if (counters.any_available()) {
+            std::cout << "  ";
+            perf::print_summary(std::cout, counters, timing.counts);
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "Checksum: " << sink << std::endl;
+
+    return 0;
+}
@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <vector>
+#include "bench_common.hpp"
 
 [[nodiscard]] auto perft(chess::Position &pos, const int depth) noexcept -> std::uint64_t {
     if (depth == 0) {
@@ -53,51 +55,65 @@ int main(const int argc, const char **argv) {
         "qb1nrkbr/1pppp1p1/1n3p2/p1B4p/8/3P1P1P/PPP1P1P1/QBNNRK1R w HEhe - 0 9",
     }};
 
-    int depth = 1;
-    auto total_time = std::chrono::milliseconds(0);
-    std::uint64_t total_nodes = 0;
-
-    // Get depth
-    if (argc > 1) {
-        depth = std::stoi(argv[1]);
+    const auto parsed = bench::parse_options(argc, argv, 1);
+    if (!parsed) {
+        return 2;
     }
+    const auto &opts = *parsed;
+    std::vector<bench::Sample> samples;
+
+    for (int run = 0; run < opts.repeats; ++run) {
+        auto total_time = std::chrono::milliseconds(0);
+        std::uint64_t total_nodes = 0;
+
+        // Print chart title
+        if (opts.format == bench::Format::Table) {
+            if (run > 0) {
+                std::cout << "\n";
+            }
+            std::cout << std::left;
+            std::cout << std::setw(5) << "Pos";
+            std::cout << std::right;
+            std::cout << std::setw(10) << "Nodes";
+            std::cout << std::setw(12) << "Nodes Sum";
+            std::cout << std::setw(9) << "Time";
+            std::cout << std::setw(10) << "Time Sum";
+            std::cout << std::left;
+            std::cout << "  FEN";
+            std::cout << "\n";
+        }
 
-    // Print chart title
-    std::cout << std::left;
-    std::cout << std::setw(5) << "Pos";
-    std::cout << std::right;
-    std::cout << std::setw(10) << "Nodes";
-    std::cout << std::setw(12) << "Nodes Sum";
-    std::cout << std::setw(9) << "Time";
-    std::cout << std::setw(10) << "Time Sum";
-    std::cout << std::left;
-    std::cout << "  FEN";
-    std::cout << "\n";
-
-    for (std::size_t i = 0; i < fens.size(); ++i) {
-        auto pos = chess::Position(fens.at(i));
-
-        // Perft
-        const auto t0 = std::chrono::steady_clock::now();
-        const auto nodes = perft(pos, depth);
-        const auto t1 = std::chrono::steady_clock::now();
-        const auto dt = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
-
-        total_time += dt;
-        total_nodes += nodes;
-
-        // Print chart row
-        std::cout << std::left;
-        std::cout << std::setw(5) << i + 1;
-        std::cout << std::right;
-        std::cout << std::setw(10) << nodes;
-        std::cout << std::setw(12) << total_nodes;
-        std::cout << std::setw(9) << format_ms(dt);
-        std::cout << std::setw(10) << format_ms(total_time);
-        std::cout << std::left;
-        std::cout << "  " << fens.at(i);
-        std::cout << "\n";
+        for (std::size_t i = 0; i < fens.size(); ++i) {
+            auto pos = chess::Position(fens.at(i));
+
+            // Perft
+            const auto t0 = std::chrono::steady_clock::now();
+            const auto nodes = perft(pos, opts.depth);
+            const auto t1 = std::chrono::steady_clock::now();
+            const auto dt = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+
+            total_time += dt;
+            total_nodes += nodes;
+            samples.push_back({run, static_cast<int>(i + 1), nodes, static_cast<double>(us.count()) / 1000.0});
+
+            if (opts.format != bench::Format::Table) {
+                continue;
+            }
+
+            // Print chart row
+            std::cout << std::left;
+            std::cout << std::setw(5) << i + 1;
+            std::cout << std::right;
+            std::cout << std::setw(10) << nodes;
+            std::cout << std::setw(12) << total_nodes;
+            std::cout << std::setw(9) << format_ms(dt);
+            std::cout << std::setw(10) << format_ms(total_time);
+            std::cout << std::left;
+            std::cout << "  " << fens.at(i);
+            std::cout << "\n";
+        }
     }
 
-    return 0;
+    return bench::report("bench_perft", opts, samples);
 }